@@ -20,13 +20,18 @@
 
 #define MAXITERATIONS 5
 
-void pageit(Pentry q[MAXPROCESSES]) { 
+/* Test state for one simulation (see pagerstate()) */
+struct test_state {
+    int tick;
+    int outTestRun;
+    int inTestRun;
+    int iterations;
+};
+
+static void pageit(Simulation *sim, Pentry q[MAXPROCESSES]) { 
     
-    /* Static Vars */
-    static int tick = 0;
-    static int outTestRun = 0;
-    static int inTestRun = 0;
-    static int iterations = 0;
+    /* Test State */
+    struct test_state *state = pagerstate(sim, sizeof(struct test_state));
 
     /* Local vars */
     int testProc = 0;
@@ -37,69 +42,71 @@ void pageit(Pentry q[MAXPROCESSES]) {
     /* All pages are swapped out on start */
     if(q[testProc].pages[testPage]){
 	/* Page is swapped in */
-	if(!inTestRun){
-	    fprintf(stdout, "%4d - %d:%d is swapped in\n", tick, testProc, testPage);
+	if(!state->inTestRun){
+	    fprintf(stdout, "%4d - %d:%d is swapped in\n", state->tick, testProc, testPage);
 	    fprintf(stdout, "%4d - q[%d].pages[%d] = %ld\n",
-		    tick, testProc, testPage, q[testProc].pages[testPage]);
+		    state->tick, testProc, testPage, q[testProc].pages[testPage]);
 	    
-	    pageinret = pagein(testProc, testPage);
+	    pageinret = pagein(sim, testProc, testPage);
 	    fprintf(stdout, "%4d - pagein(%d, %d) returns %d\n",
-		    tick, testProc, testPage, pageinret);	    
+		    state->tick, testProc, testPage, pageinret);	    
 
 	    fprintf(stdout, "%4d - q[%d].pages[%d] = %ld\n",
-		    tick, testProc, testPage, q[testProc].pages[testPage]);
+		    state->tick, testProc, testPage, q[testProc].pages[testPage]);
 
-	    pageoutret = pageout(testProc, testPage);
+	    pageoutret = pageout(sim, testProc, testPage);
 	    fprintf(stdout, "%4d - pageout(%d, %d) returns %d\n",
-		    tick, testProc, testPage, pageoutret);
+		    state->tick, testProc, testPage, pageoutret);
 	    if(pageoutret){
 		/* Wait for pageout to complete */
-		inTestRun = 1;
-		outTestRun = 0;
-		iterations++;
+		state->inTestRun = 1;
+		state->outTestRun = 0;
+		state->iterations++;
 	    }
 
 	    fprintf(stdout, "%4d - q[%d].pages[%d] = %ld\n",
-		    tick, testProc, testPage, q[testProc].pages[testPage]);
+		    state->tick, testProc, testPage, q[testProc].pages[testPage]);
 	}
     }
     else{
 	/* Page is swapped out */
-	if(!outTestRun){
-	    fprintf(stdout, "%4d - %d:%d is swapped out\n", tick, testProc, testPage);
+	if(!state->outTestRun){
+	    fprintf(stdout, "%4d - %d:%d is swapped out\n", state->tick, testProc, testPage);
 	    fprintf(stdout, "%4d - q[%d].pages[%d] = %ld\n",
-		    tick, testProc, testPage, q[testProc].pages[testPage]);
+		    state->tick, testProc, testPage, q[testProc].pages[testPage]);
 	    
-	    pageoutret = pageout(testProc, testPage);
+	    pageoutret = pageout(sim, testProc, testPage);
 	    fprintf(stdout, "%4d - pageout(%d, %d) returns %d\n",
-		    tick, testProc, testPage, pageoutret);
+		    state->tick, testProc, testPage, pageoutret);
 	    
 	    fprintf(stdout, "%4d - q[%d].pages[%d] = %ld\n",
-		    tick, testProc, testPage, q[testProc].pages[testPage]);
+		    state->tick, testProc, testPage, q[testProc].pages[testPage]);
 	    
-	    pageinret = pagein(testProc, testPage);
+	    pageinret = pagein(sim, testProc, testPage);
 	    fprintf(stdout, "%4d - pagein(%d, %d) returns %d\n",
-		    tick, testProc, testPage, pageinret);
+		    state->tick, testProc, testPage, pageinret);
 	    if(pageinret){
 		/* Wait for pagein to complete */
-		outTestRun = 1;
-		inTestRun = 0;
-		iterations++;
+		state->outTestRun = 1;
+		state->inTestRun = 0;
+		state->iterations++;
 	    }else{
-		fprintf(stdout, "%4d - pageout in progress...\n", tick);
+		fprintf(stdout, "%4d - pageout in progress...\n", state->tick);
 	    }
 
 	    fprintf(stdout, "%4d - q[%d].pages[%d] = %ld\n",
-		    tick, testProc, testPage, q[testProc].pages[testPage]);
+		    state->tick, testProc, testPage, q[testProc].pages[testPage]);
 	}
     }
    
     /* Run test for I state change iterations */
-    if(iterations > MAXITERATIONS){
+    if(state->iterations > MAXITERATIONS){
 	fprintf(stdout, "API Test Exiting\n");
 	exit(EXIT_SUCCESS);
     }
 
-    tick++;
+    state->tick++;
+
+}
 
-} 
+const Pager api_pager = { "api", pageit, NULL };
@@ -0,0 +1,322 @@
+/*
+ * File: main.c
+ *
+ * Project: CSCI 3753 Programming Assignment 4
+ * Create Date: 2026/10/16
+ * Modify Date: 2026/10/16
+ * Description:
+ * 	This is the command line front end of the simulator:
+ *      it runs one simulation for each pager named by -pager.
+ */
+
+#include <stdio.h> 
+#include <string.h>
+#include <stdlib.h> 
+#include <signal.h>
+#include <time.h> 
+
+#include "simulator.h"
+#include "trace.h"
+#include "workload.h"
+#include "program.h"
+
+#define MAXPAGERS 16 	/* pagers compared in one run */ 
+
+static Simulation *mainsim = NULL; /* run of the command line */ 
+static void endit() { if (mainsim) sim_print(mainsim); exit(0); } 
+
+int main(int argc, char **argv) { 
+    
+    long i,errors=0,help=0,csv=FALSE,trace=FALSE; 
+    const char *stats=NULL; 
+    const Pager *run[MAXPAGERS]; 
+    long nrun=0; 
+    Simoptions opt; 
+    Workload *workload=NULL; 
+    Program *programs=NULL; 
+    long nprograms=0; 
+ 
+    sim_defaults(&opt); 
+    signal(SIGINT, endit); 
+    
+    for (i=1; i<argc; i++) { 
+	if (strcmp(argv[i],"-help")==0) { 
+	    help++;
+	} else if (strcmp(argv[i],"-all")==0) { 
+	    opt.log |= LOG_LOAD|LOG_BLOCK|LOG_PAGE|LOG_BRANCH; 
+	} else if (strcmp(argv[i],"-load")==0) { 
+	    opt.log |= LOG_LOAD; 
+	} else if (strcmp(argv[i],"-block")==0) { 
+	    opt.log |= LOG_BLOCK; 
+	} else if (strcmp(argv[i],"-page")==0) { 
+	    opt.log |= LOG_PAGE; 
+	} else if (strcmp(argv[i],"-branch")==0) { 
+	    opt.log |= LOG_BRANCH; 
+	} else if (strcmp(argv[i],"-dead")==0) { 
+	    opt.log |= LOG_DEAD; 
+	} else if (strcmp(argv[i],"-warp")==0) { 
+	    opt.warp = TRUE; 
+	} else if (strcmp(argv[i],"-timing")==0) { 
+	    opt.timing = TRUE; 
+	} else if (strcmp(argv[i],"-seed")==0 && i+1<argc) { 
+	    if (sscanf(argv[++i],"%ld",&opt.seed)!=1) {
+		fprintf(stderr,
+			"%s: could not read random seed from command line\n",
+			argv[0]); 
+		errors++; 
+	    } else if (opt.seed<1 || opt.seed>((1<<30)-1)) {
+		fprintf(stderr,
+			"%s: random seed must be between 1 and %d\n",
+			argv[0], (1<<30)-1); 
+		errors++; 
+	    } 
+	} else if (strcmp(argv[i],"-csv")==0) { 
+	    csv = TRUE; 
+	} else if (strcmp(argv[i],"-trace")==0) { 
+	    trace = TRUE; 
+	} else if (strcmp(argv[i],"-stats")==0 && i+1<argc) { 
+	    stats = argv[++i]; 
+	} else if (strcmp(argv[i],"-workload")==0 && i+1<argc) { 
+	    Workload *w = workload_open(argv[++i]); 
+	    if (!w) { 
+		errors++; 
+	    } else { 
+		if (workload) workload_close(workload); 
+		opt.workload = workload = w; 
+	    } 
+	} else if (strcmp(argv[i],"-programs")==0 && i+1<argc) { 
+	    char *name = strtok(argv[++i], ","); 
+	    for (; name; name = strtok(NULL, ",")) 
+		if (!pseudo_load(name, &programs, &nprograms)) errors++; 
+	} else if (strcmp(argv[i],"-pager")==0 && i+1<argc) { 
+	    char *name = strtok(argv[++i], ","); 
+	    for (; name; name = strtok(NULL, ",")) { 
+		if (nrun>=MAXPAGERS) { 
+		    fprintf(stderr, "%s: at most %d pagers\n", argv[0], MAXPAGERS); 
+		    errors++; 
+		} else if (!(run[nrun++] = pager_find(name))) { 
+		    fprintf(stderr, "%s: unknown pager %s\n", argv[0], name); 
+		    errors++; 
+		} 
+	    } 
+	} else if (strcmp(argv[i],"-procs")==0 && i+1<argc) { 
+	    if (sscanf(argv[++i],"%ld",&opt.procs)!=1) {
+		fprintf(stderr,
+			"%s: could not read number of processors from command line\n",
+			argv[0]); 
+		errors++; 
+	    } 
+	} else if (strcmp(argv[i],"-frames")==0 && i+1<argc) { 
+	    if (sscanf(argv[++i],"%ld",&opt.frames)!=1) {
+		fprintf(stderr,
+			"%s: could not read number of physical pages from command line\n",
+			argv[0]); 
+		errors++; 
+	    } else if (opt.frames<1) {
+		fprintf(stderr,
+			"%s: number of physical pages must be positive\n",
+			argv[0]); 
+		errors++; 
+	    } 
+	} else if (strcmp(argv[i],"-pagesize")==0 && i+1<argc) { 
+	    if (sscanf(argv[++i],"%ld",&opt.pagesize)!=1) {
+		fprintf(stderr,
+			"%s: could not read page size from command line\n",
+			argv[0]); 
+		errors++; 
+	    } 
+	} else if (strcmp(argv[i],"-maxpages")==0 && i+1<argc) { 
+	    if (sscanf(argv[++i],"%ld",&opt.maxpages)!=1) {
+		fprintf(stderr,
+			"%s: could not read pages per process from command line\n",
+			argv[0]); 
+		errors++; 
+	    } 
+	} else if (strcmp(argv[i],"-readwait")==0 && i+1<argc) { 
+	    if (sscanf(argv[++i],"%ld",&opt.readwait)!=1) {
+		fprintf(stderr,
+			"%s: could not read ticks to page in from command line\n",
+			argv[0]); 
+		errors++; 
+	    } 
+	} else if (strcmp(argv[i],"-writewait")==0 && i+1<argc) { 
+	    if (sscanf(argv[++i],"%ld",&opt.writewait)!=1) {
+		fprintf(stderr,
+			"%s: could not read ticks to page out from command line\n",
+			argv[0]); 
+		errors++; 
+	    } 
+	} else if (strcmp(argv[i],"-channels")==0 && i+1<argc) { 
+	    if (sscanf(argv[++i],"%ld",&opt.channels)!=1) {
+		fprintf(stderr,
+			"%s: could not read swap device channels from command line\n",
+			argv[0]); 
+		errors++; 
+	    } 
+	} else if (strcmp(argv[i],"-bandwidth")==0 && i+1<argc) { 
+	    if (sscanf(argv[++i],"%ld",&opt.bandwidth)!=1) {
+		fprintf(stderr,
+			"%s: could not read swap device bandwidth from command line\n",
+			argv[0]); 
+		errors++; 
+	    } 
+	} else if (strcmp(argv[i],"-ioqueue")==0 && i+1<argc) { 
+	    if (sscanf(argv[++i],"%ld",&opt.ioqueue)!=1) {
+		fprintf(stderr,
+			"%s: could not read swap device queue length from command line\n",
+			argv[0]); 
+		errors++; 
+	    } 
+	} else if (strcmp(argv[i],"-iosched")==0 && i+1<argc) { 
+	    if ((opt.iosched = iosched_find(argv[++i]))<0) { 
+		fprintf(stderr, "%s: unknown swap device scheduler %s\n", argv[0], argv[i]); 
+		errors++; 
+	    } 
+	} else if (strcmp(argv[i],"-iodeadline")==0 && i+1<argc) { 
+	    if (sscanf(argv[++i],"%ld",&opt.iodeadline)!=1) {
+		fprintf(stderr,
+			"%s: could not read prefetch deadline from command line\n",
+			argv[0]); 
+		errors++; 
+	    } 
+	} else if (strcmp(argv[i],"-giveup")==0 && i+1<argc) { 
+	    if (sscanf(argv[++i],"%ld",&opt.giveup)!=1 || opt.giveup<0) {
+		fprintf(stderr,
+			"%s: could not read ticks to give up after from command line\n",
+			argv[0]); 
+		errors++; 
+	    } 
+	} else if (strcmp(argv[i],"-pagewait")==0 && i+1<argc) { 
+	    if (sscanf(argv[++i],"%ld",&opt.pagewait)!=1) {
+		fprintf(stderr,
+			"%s: could not read page wait from command line\n",
+			argv[0]); 
+		errors++; 
+	    } 
+        } else { 
+	    fprintf(stderr, "t4: unrecognized argument %s\n", argv[i]); 
+	    errors++; 
+ 	} 
+    } 
+    opt.programs = programs; 
+    opt.nprograms = nprograms; 
+    if (!nrun) run[nrun++] = opt.pager; 
+    for (i=0; i<nrun && !errors; i++) { 
+	const char *why; 
+	opt.pager = run[i]; 
+	if ((why = sim_check(&opt))) { 
+	    fprintf(stderr, "%s: pager %s: %s\n", argv[0], run[i]->name, why); 
+	    errors++; 
+	} else if (nrun>1 && strcmp(run[i]->name,"api")==0) { 
+	    /* it exits when its test ends, and the pagers after it 
+	       would never run */ 
+	    fprintf(stderr, "%s: pager api ends the process; run it alone\n", argv[0]); 
+	    errors++; 
+	} 
+    } 
+    if (errors || help) { 
+	fprintf(stderr, "%s usage: %s \n", argv[0], argv[0]); 
+        fprintf(stderr, "  -all       log everything\n"); 
+	fprintf(stderr, "  -load      log loading of processes\n"); 
+	fprintf(stderr, "  -unload    log unloading of processes\n"); 
+	fprintf(stderr, "  -branch    log program branches\n"); 
+	fprintf(stderr, "  -page      log page in and out\n"); 
+	fprintf(stderr, "  -seed 512  set random seed to 512\n"); 
+	fprintf(stderr, "  -procs 4   run only four processors (%d)\n", MAXPROCESSES); 
+	fprintf(stderr, "  -frames 50 use only 50 physical pages\n"); 
+	fprintf(stderr, "  -pagesize 64   make pages 64 lines long (%d)\n", PAGESIZE); 
+	fprintf(stderr, "  -maxpages 40   give each process 40 pages (%d)\n", MAXPROCPAGES); 
+	fprintf(stderr, "  -pagewait 200  take 200 ticks to page in or out (%d)\n", PAGEWAIT); 
+	fprintf(stderr, "  -readwait 50   take 50 ticks to page in (pagewait)\n"); 
+	fprintf(stderr, "  -writewait 200 take 200 ticks to page out (pagewait)\n"); 
+	fprintf(stderr, "  -channels 4    let the swap device move 4 pages at once (any)\n"); 
+	fprintf(stderr, "  -bandwidth 20  let it start 20 pages per 1000 ticks (no cap)\n"); 
+	fprintf(stderr, "  -ioqueue 16    let 16 requests wait for it, refusing more (any)\n"); 
+	fprintf(stderr, "  -iosched demand  start demand pageins first: fifo, demand or deadline\n"); 
+	fprintf(stderr, "  -iodeadline 300  let prefetches wait 300 ticks at most with deadline (readwait)\n"); 
+	fprintf(stderr, "  -dead      detect deadlocks\n"); 
+	fprintf(stderr, "  -warp      skip ticks in which nothing can change\n"); 
+	fprintf(stderr, "  -giveup 1000 end a run once no process has run and no page moved for 1000 ticks\n"); 
+	fprintf(stderr, "  -timing    report wall time of each phase of a tick and of the pager\n"); 
+	fprintf(stderr, "  -csv       generate output.csv and pages.csv for graphing\n");
+	fprintf(stderr, "  -trace     generate trace.bin, the same events in binary\n");
+	fprintf(stderr, "  -stats stats.json  write per process and per kind metrics\n");
+	fprintf(stderr, "             (as csv if the name ends in .csv)\n");
+	fprintf(stderr, "  -workload file.pcs  run recorded pc streams instead of the programs\n");
+	fprintf(stderr, "  -programs pgm1.pseudo,pgm2.pseudo  run these programs instead\n");
+	fprintf(stderr, "  -pager lru,predict  compare pagers on the same jobs:"); 
+	for (i=0; pagers[i]; i++) fprintf(stderr, " %s", pagers[i]->name); 
+	fprintf(stderr, "\n             or a shared object such as ./mypager.so\n"); 
+	if(errors) {
+	    return EXIT_FAILURE;
+	}
+	else {
+	    return EXIT_SUCCESS;
+	}
+    } 
+    if (opt.seed==0) { 
+	opt.seed = (time(NULL)*38491+71831+time(NULL)*time(NULL))&((1<<30)-1); 
+    } 
+
+    /* every pager sees the job queue generated from the same seed */ 
+    for (i=0; i<nrun; i++) { 
+	opt.pager = run[i]; 
+	if (csv) { 
+	    char name[FILENAME_MAX]; 
+	    if (nrun>1) snprintf(name, sizeof(name), "output-%s.csv", run[i]->name); 
+	    else        snprintf(name, sizeof(name), "output.csv"); 
+	    opt.output = fopen(name, "w"); 
+	    if (!opt.output) { 
+		fprintf(stderr, "%s: could not open %s for writing\n", argv[0], name); 
+		return EXIT_FAILURE; 
+	    } 
+	    if (nrun>1) snprintf(name, sizeof(name), "pages-%s.csv", run[i]->name); 
+	    else        snprintf(name, sizeof(name), "pages.csv"); 
+	    opt.pages = fopen(name, "w"); 
+	    if (!opt.pages) { 
+		fprintf(stderr, "%s: could not open %s for writing\n", argv[0], name); 
+		return EXIT_FAILURE; 
+	    } 
+	} 
+	if (trace) { 
+	    char name[FILENAME_MAX]; 
+	    Traceheader h; 
+	    memset(&h, 0, sizeof(h)); 
+	    h.procs = opt.procs; 
+	    h.seed = opt.seed; 
+	    h.frames = opt.frames; 
+	    strncpy(h.pager, run[i]->name, sizeof(h.pager)-1); 
+	    if (nrun>1) snprintf(name, sizeof(name), "trace-%s.bin", run[i]->name); 
+	    else        snprintf(name, sizeof(name), "trace.bin"); 
+	    opt.trace = trace_create(name, &h); 
+	    if (!opt.trace) { 
+		fprintf(stderr, "%s: could not open %s for writing\n", argv[0], name); 
+		return EXIT_FAILURE; 
+	    } 
+	} 
+	if (stats) { 
+	    char name[FILENAME_MAX]; 
+	    const char *dot = strrchr(stats, '.'); 
+	    if (!dot || strchr(dot, '/')) dot = stats+strlen(stats); 
+	    /* stats.json becomes stats-lru.json, stats-predict.json, ... */ 
+	    if (nrun>1) snprintf(name, sizeof(name), "%.*s-%s%s", 
+				 (int)(dot-stats), stats, run[i]->name, dot); 
+	    else        snprintf(name, sizeof(name), "%s", stats); 
+	    opt.stats = fopen(name, "w"); 
+	    if (!opt.stats) { 
+		fprintf(stderr, "%s: could not open %s for writing\n", argv[0], name); 
+		return EXIT_FAILURE; 
+	    } 
+	    opt.statscsv = strcmp(dot, ".csv")==0; 
+	} 
+	mainsim = sim_create(&opt); 
+	sim_run(mainsim); 
+	sim_destroy(mainsim); 
+	mainsim = NULL; 
+    } 
+    if (workload) workload_close(workload); 
+    free(programs); 
+
+    return EXIT_SUCCESS;
+
+} 
@@ -0,0 +1,310 @@
+/*
+ * File: pagebench.c
+ *
+ * Project: CSCI 3753 Programming Assignment 4
+ * Create Date: 2026/10/16
+ * Modify Date: 2026/10/16
+ * Description:
+ * 	This is a microbenchmark of pager decision time: it calls
+ *      each pager's pageit() on synthetic Pentry tables (a mostly
+ *      idle machine, full memory, a fault storm, and every
+ *      processor running) and prints the time and heap
+ *      allocations per call. It links in place of simulator.o:
+ *      pagein() and pageout() act on a small model of memory
+ *      with the simulator's rules, so no job runs and the cost
+ *      of the pager is measured apart from how well it pages.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "simulator.h"
+
+#define LATENCYBUCKETS (64*16) 	/* 16 per power of two of ns */
+
+/* a synthetic load */
+typedef struct scenario {
+    const char *name;
+    long active;        /* processes running */
+    long resident;      /* pages of each in memory at the start */
+    long branch;        /* one call in branch jumps to a random pc;
+                           0 loops over the resident pages */
+} Scenario;
+
+static const Scenario scenarios[] = {
+    { "idle",  1,                 0, 64 },
+    { "full",  MAXPROCESSES,      PHYSICALPAGES/MAXPROCESSES, 0 },
+    { "storm", MAXPROCESSES,      PHYSICALPAGES/MAXPROCESSES, 1 },
+    { "many",  MAXPROCESSES,      0, 64 },
+};
+#define NSCENARIOS (long)(sizeof(scenarios)/sizeof(scenarios[0]))
+
+/* the machine a pager sees: pages count down as in simulator.c,
+   >0 coming in, 0 in, -1 to -pagewait going out, below that free */
+struct simulation {
+    Geometry geometry;
+    long pagesavail;
+    long pages[MAXPROCESSES][MAXPROCPAGES];
+    Pentry q[MAXPROCESSES];
+    void *pagerdata;
+    long pageins, pageouts;
+};
+
+/* heap allocations made by the pagers (through the linker's --wrap) */
+static long allocations;
+
+void *__real_malloc(size_t size);
+void *__real_calloc(size_t n, size_t size);
+void *__real_realloc(void *p, size_t size);
+
+void *__wrap_malloc(size_t size) { allocations++; return __real_malloc(size); }
+void *__wrap_calloc(size_t n, size_t size) { allocations++; return __real_calloc(n, size); }
+void *__wrap_realloc(void *p, size_t size) { allocations++; return __real_realloc(p, size); }
+
+/*==========================================
+   the pager API, on the model of memory
+  ==========================================*/
+
+int pagein(Simulation *sim, int process, int page) {
+    long *p;
+    sim->pageins++;
+    if (process<0 || process>=MAXPROCESSES || !sim->q[process].active
+     || page<0 || page>=MAXPROCPAGES)
+        return FALSE;
+    p = &sim->pages[process][page];
+    if (*p>=0) return TRUE; /* on its way */
+    if (sim->pagesavail==0 || *p>=-sim->geometry.pagewait) return FALSE;
+    *p = sim->geometry.pagewait;
+    sim->pagesavail--;
+    return TRUE;
+}
+
+int pageout(Simulation *sim, int process, int page) {
+    long *p;
+    sim->pageouts++;
+    if (process<0 || process>=MAXPROCESSES || !sim->q[process].active
+     || page<0 || page>=MAXPROCPAGES)
+        return FALSE;
+    p = &sim->pages[process][page];
+    if (*p<0) return TRUE; /* on its way out */
+    if (*p>0) return FALSE; /* not available to swap out */
+    *p = -1;
+    return TRUE;
+}
+
+void *pagerstate(Simulation *sim, size_t size) {
+    if (!sim->pagerdata) sim->pagerdata = calloc(1, size);
+    if (!sim->pagerdata) {
+        fprintf(stderr, "pagebench: out of memory\n");
+        exit(EXIT_FAILURE);
+    }
+    return sim->pagerdata;
+}
+
+const Geometry *sim_geometry(Simulation *sim) {
+    return &sim->geometry;
+}
+
+/* there is no job queue to look ahead in */
+long sim_nextuse(Simulation *sim, int process, int page) {
+    (void)sim; (void)process; (void)page;
+    return -1;
+}
+
+long sim_nextpage(Simulation *sim, int process, long *page) {
+    (void)sim; (void)process; (void)page;
+    return -1;
+}
+
+long sim_freeframes(Simulation *sim) {
+    return sim->pagesavail;
+}
+
+/* nor any load control: processes run as scripted */
+int sim_suspend(Simulation *sim, int process) {
+    (void)sim; (void)process;
+    return FALSE;
+}
+
+int sim_resume(Simulation *sim, int process) {
+    (void)sim; (void)process;
+    return FALSE;
+}
+
+long sim_runtime(Simulation *sim, int process) {
+    (void)sim; (void)process;
+    return -1;
+}
+
+/*==========================
+   driving the model
+  ==========================*/
+
+static void model_init(Simulation *sim, const Scenario *s) {
+    long i, j;
+    memset(sim, 0, sizeof(*sim));
+    sim->geometry.procs = MAXPROCESSES;
+    sim->geometry.maxpages = MAXPROCPAGES;
+    sim->geometry.pagesize = PAGESIZE;
+    sim->geometry.pagewait = PAGEWAIT;
+    sim->geometry.frames = PHYSICALPAGES;
+    sim->pagesavail = PHYSICALPAGES;
+    for (i=0; i<MAXPROCESSES; i++) {
+        sim->q[i].active = i<s->active;
+        sim->q[i].npages = MAXPROCPAGES;
+        for (j=0; j<MAXPROCPAGES; j++) {
+            if (sim->q[i].active && j<s->resident && sim->pagesavail>0) {
+                sim->pages[i][j] = 0;
+                sim->pagesavail--;
+            } else {
+                sim->pages[i][j] = -PAGEWAIT-1;
+            }
+        }
+    }
+}
+
+/* one tick: pages age, and each running process moves on */
+static void model_tick(Simulation *sim, const Scenario *s, unsigned short *rand) {
+    long i, j, *p;
+    for (i=0; i<MAXPROCESSES; i++) {
+        Pentry *q = sim->q+i;
+        if (!q->active) continue;
+        for (j=0; j<MAXPROCPAGES; j++) {
+            p = &sim->pages[i][j];
+            if (*p>0 || (*p<0 && *p>=-PAGEWAIT)) {
+                (*p)--;
+                if (*p<-PAGEWAIT) sim->pagesavail++;
+            }
+        }
+        if (sim->pages[i][q->pc/PAGESIZE]!=0) continue; /* blocked */
+        if (s->branch && nrand48(rand)%s->branch==0)
+            q->pc = nrand48(rand)%MAXPC;
+        else if (++q->pc >= (s->branch ? MAXPC : s->resident*PAGESIZE))
+            q->pc = 0;
+    }
+    for (i=0; i<MAXPROCESSES; i++)
+        for (j=0; j<MAXPROCPAGES; j++)
+            sim->q[i].pages[j] = sim->q[i].active && sim->pages[i][j]==0;
+}
+
+static long now(void) {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec*1000000000L + t.tv_nsec;
+}
+
+/* bucket of a latency: exact below 16 ns, then 16 per power of two */
+static long bucket(long ns) {
+    long shift = 0;
+    if (ns<16) return ns<0 ? 0 : ns;
+    while ((ns>>shift)>=32) shift++;
+    return (shift+1)*16 + ((ns>>shift)&15);
+}
+
+/* smallest latency of a bucket */
+static long bucket_floor(long b) {
+    if (b<16) return b;
+    return (16+b%16) << (b/16-1);
+}
+
+static long percentile(const long *latency, long calls, double fraction) {
+    long b, seen = 0;
+    for (b=0; b<LATENCYBUCKETS; b++) {
+        seen += latency[b];
+        if (seen>0 && seen>=fraction*calls) return bucket_floor(b);
+    }
+    return 0;
+}
+
+static void bench(const Pager *pager, const Scenario *s, long calls, long seed) {
+    static Simulation sim;
+    static long latency[LATENCYBUCKETS];
+    unsigned short rand[3];
+    long i, start, ns, total = 0, allocs;
+
+    model_init(&sim, s);
+    memset(latency, 0, sizeof(latency));
+    rand[0] = 0x330E; rand[1] = seed & 0xffff; rand[2] = (seed >> 16) & 0xffff;
+    allocations = 0;
+    for (i=0; i<calls; i++) {
+        model_tick(&sim, s, rand);
+        start = now();
+        pager->pageit(&sim, sim.q);
+        ns = now()-start;
+        total += ns;
+        latency[bucket(ns)]++;
+    }
+    allocs = allocations;
+    printf("%-10s %-6s %8ld %10.1f %9ld %9ld %9ld %9.3f %9.3f\n",
+           pager->name, s->name, calls, (double)total/calls,
+           percentile(latency, calls, 0.50), percentile(latency, calls, 0.99),
+           allocs, (double)sim.pageins/calls, (double)sim.pageouts/calls);
+    free(sim.pagerdata);
+}
+
+int main(int argc, char **argv) {
+    long i, j, errors=0, help=0;
+    long calls=100000, seed=1;
+    const Pager *pager[64];
+    long npagers=0;
+
+    for (i=1; i<argc; i++) {
+        if (strcmp(argv[i],"-help")==0) {
+            help++;
+        } else if (strcmp(argv[i],"-pager")==0 && i+1<argc) {
+            char *names = strdup(argv[++i]), *name;
+            for (name=strtok(names, ","); name; name=strtok(NULL, ",")) {
+                if (npagers == 64) {
+                    fprintf(stderr, "%s: at most 64 pagers\n", argv[0]);
+                    errors++;
+                } else if (!(pager[npagers] = pager_find(name))) {
+                    fprintf(stderr, "%s: unknown pager %s\n", argv[0], name);
+                    errors++;
+                } else if (!pager[npagers]->pageit) {
+                    fprintf(stderr, "%s: pager %s has no pageit()\n", argv[0], name);
+                    errors++;
+                } else {
+                    npagers++;
+                }
+            }
+            free(names);
+        } else if (strcmp(argv[i],"-calls")==0 && i+1<argc) {
+            calls = atol(argv[++i]);
+            if (calls<1) {
+                fprintf(stderr, "%s: bad number of calls %s\n", argv[0], argv[i]);
+                errors++;
+            }
+        } else if (strcmp(argv[i],"-seed")==0 && i+1<argc) {
+            seed = atol(argv[++i]);
+        } else {
+            fprintf(stderr, "%s: unrecognized argument %s\n", argv[0], argv[i]);
+            errors++;
+        }
+    }
+    if (errors || help) {
+        fprintf(stderr, "%s usage: %s \n", argv[0], argv[0]);
+        fprintf(stderr, "  -pager lru,basic   pagers to time (default: all with pageit()):");
+        for (i=0; pagers[i]; i++)
+            if (pagers[i]->pageit && strcmp(pagers[i]->name, "api")!=0)
+                fprintf(stderr, " %s", pagers[i]->name);
+        fprintf(stderr, "\n");
+        fprintf(stderr, "  -calls 100000      calls of each pager per load (default 100000)\n");
+        fprintf(stderr, "  -seed 512          random seed of the loads (default 1)\n");
+        return errors ? EXIT_FAILURE : EXIT_SUCCESS;
+    }
+    if (!npagers) /* api checks the simulator rather than paging */
+        for (i=0; pagers[i]; i++)
+            if (pagers[i]->pageit && strcmp(pagers[i]->name, "api")!=0)
+                pager[npagers++] = pagers[i];
+
+    printf("%-10s %-6s %8s %10s %9s %9s %9s %9s %9s\n", "pager", "load", "calls",
+           "ns/call", "p50 ns", "p99 ns", "allocs", "pageins", "pageouts");
+    printf("%-10s %-6s %8s %10s %9s %9s %9s %9s %9s\n", "", "", "", "", "", "", "(total)",
+           "(/call)", "(/call)");
+    for (i=0; i<npagers; i++)
+        for (j=0; j<NSCENARIOS; j++)
+            bench(pager[i], scenarios+j, calls, seed);
+    return EXIT_SUCCESS;
+}
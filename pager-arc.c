@@ -0,0 +1,220 @@
+/*/////////////////////////////////////////////////////////////////////
+File: pager-arc.c
+
+Project: CSCI 3753 Programming Assignment 4
+Create Date: 2026/10/16
+
+Description:
+This file contains an adaptive replacement cache (ARC) paging
+implementation. Pure recency lets a long linear run, such as the
+branch arm of pgm1 or the whole of pgm4, push out the pages of loops
+that will be run on again. ARC splits the resident pages in two LRU
+lists: T1 holds pages run on once since they came in, T2 pages run on
+again. Pages paged out leave a ghost (no frame, just the name) in B1
+or B2. A fault on a ghost of B1 says T1 was too small, one on a ghost
+of B2 that T2 was, and the target size p of T1 moves that way, so
+scans stay in T1 and are paged out first, without a knob to tune.
+
+The cache is all of physical memory: one set of lists over the pages
+of all processes, with c = frames (as glru, a fault may take a page of
+any process). A page is run on when its process comes to it; pages a
+process runs on are never paged out. This paging implementation can be
+called with './simulate -pager arc'.
+
+*//////////////////////////////////////////////////////////////////////
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "simulator.h"
+#include "pagerlib.h"
+
+/* the lists; a page is on at most one */
+#define T1 0    /* resident (or coming), run on once */
+#define T2 1    /* resident (or coming), run on again */
+#define B1 2    /* ghosts of pages paged out of T1 */
+#define B2 3    /* ghosts of pages paged out of T2 */
+#define NLISTS 4
+
+/* pager state for one simulation (see pagerstate()); the arrays
+   are carved from data[], with one entry per process page */
+struct arc_state {
+    int initialized;
+    int procs, maxpages;
+    long c, p;      // cache size, and target size of T1
+    Pagerbase base; // waiting processes and pageouts on their way
+
+    // the lists, least recently used first, as doubly linked
+    // lists of proc*maxpages+page...
+    int head[NLISTS], tail[NLISTS];
+    long size[NLISTS];
+    int *next, *prev;
+    int *list;      // list of each page, or NONE
+
+    int data[];
+};
+
+static void list_remove(struct arc_state *state, int frame) {
+    int l = state->list[frame];
+    if (l == NONE) return;
+    state->list[frame] = NONE;
+    state->size[l]--;
+    if (state->prev[frame] != NONE) state->next[state->prev[frame]] = state->next[frame];
+    else state->head[l] = state->next[frame];
+    if (state->next[frame] != NONE) state->prev[state->next[frame]] = state->prev[frame];
+    else state->tail[l] = state->prev[frame];
+}
+
+/* put a page at the most recently used end of list l */
+static void list_append(struct arc_state *state, int frame, int l) {
+    list_remove(state, frame);
+    state->list[frame] = l;
+    state->size[l]++;
+    state->next[frame] = NONE;
+    state->prev[frame] = state->tail[l];
+    if (state->tail[l] != NONE) state->next[state->tail[l]] = frame;
+    else state->head[l] = frame;
+    state->tail[l] = frame;
+}
+
+/* page out the least recently used page of list l, leaving its
+   ghost on ghost; pages that can't go now (run on, or still coming
+   in) move to the recent end, at most procs of them */
+static int arc_evict(Simulation *sim, struct arc_state *state, int l, int ghost) {
+    int frame, proc, page, seen;
+    for (seen=0; seen<=state->procs && state->head[l] != NONE; seen++) {
+        frame = state->head[l];
+        proc = frame / state->maxpages;
+        page = frame % state->maxpages;
+        if (state->base.current[proc] != page
+         && pagerbase_pageout(sim, &state->base, proc, page)) {
+            list_append(state, frame, ghost);
+            return 1;
+        }
+        list_append(state, frame, l);
+    }
+    return 0;
+}
+
+/* ARC's REPLACE: take from T1 while it is over its target (or at it,
+   when the fault is on a ghost of B2), else from T2 */
+static void arc_replace(Simulation *sim, struct arc_state *state, int inb2) {
+    long t1 = state->size[T1];
+    if (t1 > 0 && (t1 > state->p || (inb2 && t1 == state->p))) {
+        if (!arc_evict(sim, state, T1, B1)) arc_evict(sim, state, T2, B2);
+    } else {
+        if (!arc_evict(sim, state, T2, B2)) arc_evict(sim, state, T1, B1);
+    }
+}
+
+/* a page that was not resident is coming in: learn from its ghost,
+   and keep the ghosts to c per side and 2c in all */
+static void arc_miss(struct arc_state *state, int frame) {
+    long b1 = state->size[B1], b2 = state->size[B2];
+    switch (state->list[frame]) {
+    case B1:
+        // T1 was too small...
+        state->p += b2 > b1 ? b2/b1 : 1;
+        if (state->p > state->c) state->p = state->c;
+        list_append(state, frame, T2);
+        return;
+    case B2:
+        // T2 was too small...
+        state->p -= b1 > b2 ? b1/b2 : 1;
+        if (state->p < 0) state->p = 0;
+        list_append(state, frame, T2);
+        return;
+    }
+    if (state->size[T1] + b1 >= state->c) {
+        if (b1 > 0) list_remove(state, state->head[B1]);
+    } else if (state->size[T1] + state->size[T2] + b1 + b2 >= 2*state->c) {
+        if (b2 > 0) list_remove(state, state->head[B2]);
+    }
+    list_append(state, frame, T1);
+}
+
+/*/////////////////////////////////////////////////////////////////////
+pageupdate(Simulation *sim, const Pevent *events, long nevents)
+
+    This paging function applies each change to its lists: a process
+    coming to a page in T1 or T2 is a hit and moves it to the recent
+    end of T2, and leaving a page makes it the most recent of its
+    list. It then starts a pagein for every waiting process, which
+    puts the page on T1 or, if it had a ghost, on T2 and adapts p.
+    Where no frame is free, it pages out by ARC's REPLACE, one page
+    per waiting process that has no pageout on its way yet, plus a
+    small reserve.
+
+*//////////////////////////////////////////////////////////////////////
+
+static void pageupdate(Simulation *sim, const Pevent *events, long nevents) {
+    /* Pager state */
+    const Geometry *g = sim_geometry(sim);
+    long nframes = g->procs*g->maxpages;
+    struct arc_state *state = pagerstate(sim, sizeof(struct arc_state)
+                                         + (3*nframes + PAGERBASE_INTS(g))*sizeof(int));
+    Pagerbase *b = &state->base;
+    long i;
+    int frame, proc, page, left, l;
+
+    // initialize on first call...
+    if (!state->initialized) {
+        state->procs = g->procs;
+        state->maxpages = g->maxpages;
+        state->c = g->frames;
+        state->next = pagerbase_init(b, g, state->data);
+        state->prev = state->next + nframes;
+        state->list = state->prev + nframes;
+        for (l=0; l<NLISTS; l++) state->head[l] = state->tail[l] = NONE;
+        for (frame=0; frame<nframes; frame++) state->list[frame] = NONE;
+        state->initialized = 1;
+    }
+    if (!nevents) return;
+
+    /* apply the changes */
+    for (i=0; i<nevents; i++) {
+        proc = events[i].proc;
+        page = events[i].page;
+        frame = proc*state->maxpages + page;
+        switch (events[i].type) {
+        case PE_CROSS:
+            // the page left behind was in use until now...
+            left = proc*state->maxpages + b->current[proc];
+            l = state->list[left];
+            if (l == T1 || l == T2) list_append(state, left, l);
+            // ...and coming to a resident page is a hit...
+            if (state->list[frame] == T1 || state->list[frame] == T2)
+                list_append(state, frame, T2);
+            break;
+        case PE_UNLOAD:
+            // the simulator freed every page of the process...
+            for (page=0; page<state->maxpages; page++)
+                list_remove(state, proc*state->maxpages + page);
+            break;
+        case PE_CANCEL:
+            // it never came in, so it leaves no ghost...
+            l = state->list[frame];
+            if (l == T1 || l == T2) list_remove(state, frame);
+            break;
+        }
+        pagerbase_event(b, events+i);
+    }
+
+    /* page in what the waiting processes need */
+    for (i=0; i<b->nwaiting; ) {
+        proc = b->waiting[i];
+        frame = proc*state->maxpages + b->current[proc];
+        l = state->list[frame];
+        if (pagein(sim, proc, b->current[proc])) {
+            // on its way or already in...
+            if (l != T1 && l != T2) arc_miss(state, frame);
+            b->waiting[i] = b->waiting[--b->nwaiting];
+        } else {
+            // no free frame: make one, unless enough are coming...
+            if (pagerbase_reserve(b)) arc_replace(sim, state, l == B2);
+            i++;
+        }
+    }
+}
+
+const Pager arc_pager = { "arc", NULL, pageupdate };
@@ -18,7 +18,7 @@
 
 #include "simulator.h"
 
-void pageit(Pentry q[MAXPROCESSES]) { 
+static void pageit(Simulation *sim, Pentry q[MAXPROCESSES]) { 
     
     /* Local vars */
     int proc;
@@ -37,13 +37,13 @@ void pageit(Pentry q[MAXPROCESSES]) {
 	    /* Is page swaped-out? */
 	    if(!q[proc].pages[page]) {
 		/* Try to swap in */
-		if(!pagein(proc,page)) {
+		if(!pagein(sim,proc,page)) {
 		    /* If swapping fails, swap out another page */
 		    for(oldpage=0; oldpage < q[proc].npages; oldpage++) {
 	 		/* Make sure page isn't one I want */
 			if(oldpage != page) {
 			    /* Try to swap-out */
-			    if(pageout(proc,oldpage)) {
+			    if(pageout(sim,proc,oldpage)) {
 				/* Break loop once swap-out starts*/
 				break;
 			    } 
@@ -55,4 +55,6 @@ void pageit(Pentry q[MAXPROCESSES]) {
 	    break;
 	}
     } 
-} 
+}
+
+const Pager basic_pager = { "basic", pageit, NULL };
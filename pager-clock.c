@@ -0,0 +1,196 @@
+/*/////////////////////////////////////////////////////////////////////
+File: pager-clock.c
+
+Project: CSCI 3753 Programming Assignment 4
+Create Date: 2026/10/16
+
+Description:
+This file contains CLOCK (second chance) paging implementations, the
+usual approximation of LRU. Instead of a timestamp per page and a scan
+for the oldest one, each resident page has a reference bit and sits on
+a ring that a hand sweeps: a referenced page has its bit cleared and is
+passed over, and the first unreferenced page is paged out. Each page is
+passed at most twice per pageout, so a victim costs O(1) amortized.
+
+The simulator has no hardware reference bits, so they are simulated:
+a page is referenced when its pagein ends and when its process leaves
+it (it was run on until then), and a page a process runs on is never
+paged out. 'clock' has a ring and hand per process and, like lru, only
+evicts pages of the process that faults; 'gclock' has one ring over the
+pages of all processes. These paging implementations can be called with
+'./simulate -pager clock' and './simulate -pager gclock'.
+
+*//////////////////////////////////////////////////////////////////////
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "simulator.h"
+#include "pagerlib.h"
+
+/* pager state for one simulation (see pagerstate()); the arrays
+   are carved from data[], with one entry per process page, and
+   one per process for the rings (gclock uses ring 0 only) */
+struct clock_state {
+    int initialized;
+    int global;
+    int procs, maxpages;
+    Pagerbase base; // waiting processes and pageouts on their way
+
+    // resident pages as circular doubly linked rings of
+    // proc*maxpages+page, and the page under each hand...
+    int *hand, *size;
+    int *next, *prev;
+    int *listed;
+    int *referenced;
+
+    int data[];
+};
+
+static int ring_of(struct clock_state *state, int frame) {
+    return state->global ? 0 : frame / state->maxpages;
+}
+
+/* put a page on its ring just behind the hand, so that it is the
+   last page the hand comes to */
+static void ring_insert(struct clock_state *state, int frame) {
+    int r = ring_of(state, frame);
+    int h = state->hand[r];
+    if (state->listed[frame]) return;
+    state->listed[frame] = 1;
+    if (h == NONE) {
+        state->next[frame] = state->prev[frame] = frame;
+        state->hand[r] = frame;
+    } else {
+        state->next[frame] = h;
+        state->prev[frame] = state->prev[h];
+        state->next[state->prev[h]] = frame;
+        state->prev[h] = frame;
+    }
+    state->size[r]++;
+}
+
+static void ring_remove(struct clock_state *state, int frame) {
+    int r = ring_of(state, frame);
+    if (!state->listed[frame]) return;
+    state->listed[frame] = 0;
+    if (--state->size[r] == 0) {
+        state->hand[r] = NONE;
+        return;
+    }
+    state->next[state->prev[frame]] = state->next[frame];
+    state->prev[state->next[frame]] = state->prev[frame];
+    if (state->hand[r] == frame) state->hand[r] = state->next[frame];
+}
+
+/* sweep the hand of ring r to the first page that is neither
+   referenced nor run on, and page it out; two turns at most,
+   as the first clears every reference bit */
+static void clock_evict(Simulation *sim, struct clock_state *state, int r) {
+    int frame, proc, page, steps;
+    for (steps=2*state->size[r]; steps>0 && state->hand[r] != NONE; steps--) {
+        frame = state->hand[r];
+        proc = frame / state->maxpages;
+        page = frame % state->maxpages;
+        if (state->base.current[proc] == page || state->referenced[frame]) {
+            // second chance...
+            state->referenced[frame] = 0;
+            state->hand[r] = state->next[frame];
+            continue;
+        }
+        if (pagerbase_pageout(sim, &state->base, proc, page)) ring_remove(state, frame);
+        return;
+    }
+}
+
+/*/////////////////////////////////////////////////////////////////////
+clock_update(Simulation *sim, const Pevent *events, long nevents, int global)
+
+    This paging function applies each change to its rings, reference
+    bits and list of processes waiting for a page. It then starts a
+    pagein for every waiting process and, where no frame is free,
+    sweeps a hand for a page to page out: with 'clock' the hand of the
+    waiting process, until a few of its pageouts are on their way;
+    with 'gclock' the one hand, one page per waiting process that has
+    no pageout on its way yet, plus a small reserve.
+
+*//////////////////////////////////////////////////////////////////////
+
+static void clock_update(Simulation *sim, const Pevent *events, long nevents, int global) {
+    /* Pager state */
+    const Geometry *g = sim_geometry(sim);
+    long nframes = g->procs*g->maxpages;
+    struct clock_state *state = pagerstate(sim, sizeof(struct clock_state)
+                                           + (4*nframes + 2*g->procs + PAGERBASE_INTS(g))*sizeof(int));
+    Pagerbase *b = &state->base;
+    long i;
+    int frame, proc, page, left;
+
+    // initialize on first call...
+    if (!state->initialized) {
+        state->global = global;
+        state->procs = g->procs;
+        state->maxpages = g->maxpages;
+        state->next = pagerbase_init(b, g, state->data);
+        state->prev = state->next + nframes;
+        state->listed = state->prev + nframes;
+        state->referenced = state->listed + nframes;
+        state->hand = state->referenced + nframes;
+        state->size = state->hand + g->procs;
+        for (proc=0; proc<g->procs; proc++) state->hand[proc] = NONE;
+        state->initialized = 1;
+    }
+    if (!nevents) return;
+
+    /* apply the changes */
+    for (i=0; i<nevents; i++) {
+        proc = events[i].proc;
+        page = events[i].page;
+        frame = proc*state->maxpages + page;
+        switch (events[i].type) {
+        case PE_CROSS:
+            // the page left behind was referenced until now...
+            left = proc*state->maxpages + b->current[proc];
+            if (state->listed[left]) state->referenced[left] = 1;
+            break;
+        case PE_UNLOAD:
+            // the simulator freed every page of the process...
+            for (page=0; page<state->maxpages; page++)
+                ring_remove(state, proc*state->maxpages + page);
+            break;
+        case PE_IN:
+            ring_insert(state, frame);
+            state->referenced[frame] = 1;
+            break;
+        }
+        pagerbase_event(b, events+i);
+    }
+
+    /* page in what the waiting processes need */
+    for (i=0; i<b->nwaiting; ) {
+        proc = b->waiting[i];
+        if (pagein(sim, proc, b->current[proc])) {
+            // on its way or already in...
+            b->waiting[i] = b->waiting[--b->nwaiting];
+            continue;
+        }
+        // no free frame: make one, unless enough are coming...
+        if (!state->global) {
+            if (pagerbase_ahead(b, proc)) clock_evict(sim, state, proc);
+        } else if (pagerbase_reserve(b)) {
+            clock_evict(sim, state, 0);
+        }
+        i++;
+    }
+}
+
+static void clock_local(Simulation *sim, const Pevent *events, long nevents) {
+    clock_update(sim, events, nevents, 0);
+}
+
+static void clock_global(Simulation *sim, const Pevent *events, long nevents) {
+    clock_update(sim, events, nevents, 1);
+}
+
+const Pager clock_pager = { "clock", NULL, clock_local };
+const Pager gclock_pager = { "gclock", NULL, clock_global };
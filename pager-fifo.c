@@ -0,0 +1,143 @@
+/*/////////////////////////////////////////////////////////////////////
+File: pager-fifo.c
+
+Project: CSCI 3753 Programming Assignment 4
+Create Date: 2026/10/16
+
+Description:
+This file contains a first in, first out paging implementation that is
+driven by pageupdate() instead of pageit(): the simulator reports only
+what changed since the last tick, so this pager never scans the state
+of every process and page.
+
+Resident pages of all processes are kept in one queue in the order
+their pageins ended. When a process needs a page and no frame is free,
+the oldest page in the queue is paged out, unless its own process is
+running on it. The waiting processes and the pageouts on their way
+are kept by pagerlib.c, as with every pageupdate() pager, so it runs
+with any -procs and -maxpages. This paging implementation can be called
+with './simulate -pager fifo' after compilation.
+
+*//////////////////////////////////////////////////////////////////////
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "simulator.h"
+#include "pagerlib.h"
+
+/* pager state for one simulation (see pagerstate()); the arrays
+   are carved from data[], with one entry per process page */
+struct fifo_state {
+    int initialized;
+    int maxpages;
+    Pagerbase base; // waiting processes and pageouts on their way
+
+    // resident pages, oldest first, as a doubly linked list of
+    // proc*maxpages+page...
+    int head, tail;
+    int *next, *prev;
+    int *queued;
+
+    int data[];
+};
+
+static void fifo_append(struct fifo_state *state, int frame) {
+    if (state->queued[frame]) return;
+    state->queued[frame] = 1;
+    state->next[frame] = NONE;
+    state->prev[frame] = state->tail;
+    if (state->tail != NONE) state->next[state->tail] = frame;
+    else state->head = frame;
+    state->tail = frame;
+}
+
+static void fifo_remove(struct fifo_state *state, int frame) {
+    if (!state->queued[frame]) return;
+    state->queued[frame] = 0;
+    if (state->prev[frame] != NONE) state->next[state->prev[frame]] = state->next[frame];
+    else state->head = state->next[frame];
+    if (state->next[frame] != NONE) state->prev[state->next[frame]] = state->prev[frame];
+    else state->tail = state->prev[frame];
+}
+
+/* page out the oldest resident page no process is running on */
+static void fifo_evict(Simulation *sim, struct fifo_state *state) {
+    int frame, proc, page;
+    for (frame=state->head; frame != NONE; frame=state->next[frame]) {
+        proc = frame / state->maxpages;
+        page = frame % state->maxpages;
+        if (state->base.current[proc] == page) continue;
+        if (pagerbase_pageout(sim, &state->base, proc, page)) {
+            fifo_remove(state, frame);
+            return;
+        }
+    }
+}
+
+/*/////////////////////////////////////////////////////////////////////
+pageupdate(Simulation *sim, const Pevent *events, long nevents)
+
+    This paging function first applies each change to its queue of
+    resident pages and its list of processes waiting for a page. It
+    then starts a pagein for every waiting process and, where no frame
+    is free, starts one pageout per waiting process that has none on
+    its way yet. Nothing can change on a tick without events, so such
+    ticks cost nothing.
+
+*//////////////////////////////////////////////////////////////////////
+
+static void pageupdate(Simulation *sim, const Pevent *events, long nevents) {
+    /* Pager state */
+    const Geometry *g = sim_geometry(sim);
+    long nframes = g->procs*g->maxpages;
+    struct fifo_state *state = pagerstate(sim, sizeof(struct fifo_state)
+                                          + (3*nframes + PAGERBASE_INTS(g))*sizeof(int));
+    Pagerbase *b = &state->base;
+    long i;
+    int frame, proc, page;
+
+    // initialize on first call...
+    if (!state->initialized) {
+        state->maxpages = g->maxpages;
+        state->next = pagerbase_init(b, g, state->data);
+        state->prev = state->next + nframes;
+        state->queued = state->prev + nframes;
+        state->head = state->tail = NONE;
+        state->initialized = 1;
+    }
+    if (!nevents) return;
+
+    /* apply the changes */
+    for (i=0; i<nevents; i++) {
+        proc = events[i].proc;
+        page = events[i].page;
+        frame = proc*state->maxpages + page;
+        switch (events[i].type) {
+        case PE_UNLOAD:
+            // the simulator freed every page of the process...
+            for (page=0; page<state->maxpages; page++)
+                fifo_remove(state, proc*state->maxpages + page);
+            break;
+        case PE_IN:
+            fifo_append(state, frame);
+            break;
+        }
+        pagerbase_event(b, events+i);
+    }
+
+    /* page in what the waiting processes need */
+    for (i=0; i<b->nwaiting; ) {
+        proc = b->waiting[i];
+        if (pagein(sim, proc, b->current[proc])) {
+            // on its way or already in...
+            b->waiting[i] = b->waiting[--b->nwaiting];
+        } else {
+            // no free frame: make one, unless enough are coming...
+            if (b->ngoing < b->nwaiting) fifo_evict(sim, state);
+            i++;
+        }
+    }
+}
+
+const Pager fifo_pager = { "fifo", NULL, pageupdate };
@@ -0,0 +1,155 @@
+/*/////////////////////////////////////////////////////////////////////
+File: pager-glru.c
+
+Project: CSCI 3753 Programming Assignment 4
+Create Date: 2026/10/16
+
+Description:
+This file contains a global least recently used paging implementation.
+The lru pager only pages out pages of the process that faults, so a
+process with nothing resident can fail pagein() for as long as idle
+processes hold every frame. This one picks its victim among the pages
+of all processes.
+
+Resident pages of all processes are kept in one recency list. A page
+is used for as long as its process runs on it, so it moves to the
+recent end when its process leaves it (and when its pagein ends);
+pages processes are running on are never paged out. Each change costs
+O(1) and a fault takes the least recent page, with no scan over every
+process and page. This paging implementation can be called with
+'./simulate -pager glru'.
+
+*//////////////////////////////////////////////////////////////////////
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "simulator.h"
+#include "pagerlib.h"
+
+/* pager state for one simulation (see pagerstate()); the arrays
+   are carved from data[], with one entry per process page */
+struct glru_state {
+    int initialized;
+    int procs, maxpages;
+    Pagerbase base; // waiting processes and pageouts on their way
+
+    // resident pages, least recently used first, as a doubly
+    // linked list of proc*maxpages+page...
+    int head, tail;
+    int *next, *prev;
+    int *listed;
+
+    int data[];
+};
+
+static void recency_remove(struct glru_state *state, int frame) {
+    if (!state->listed[frame]) return;
+    state->listed[frame] = 0;
+    if (state->prev[frame] != NONE) state->next[state->prev[frame]] = state->next[frame];
+    else state->head = state->next[frame];
+    if (state->next[frame] != NONE) state->prev[state->next[frame]] = state->prev[frame];
+    else state->tail = state->prev[frame];
+}
+
+/* make a resident page the most recently used */
+static void recency_touch(struct glru_state *state, int frame) {
+    recency_remove(state, frame);
+    state->listed[frame] = 1;
+    state->next[frame] = NONE;
+    state->prev[frame] = state->tail;
+    if (state->tail != NONE) state->next[state->tail] = frame;
+    else state->head = frame;
+    state->tail = frame;
+}
+
+/* page out the least recently used page of any process; a page
+   its process runs on is in use, so it goes to the recent end
+   (there are at most procs of those to pass over) */
+static void glru_evict(Simulation *sim, struct glru_state *state) {
+    int frame, proc, page, seen;
+    for (seen=0; seen<=state->procs && state->head != NONE; seen++) {
+        frame = state->head;
+        proc = frame / state->maxpages;
+        page = frame % state->maxpages;
+        if (state->base.current[proc] == page) {
+            recency_touch(state, frame);
+            continue;
+        }
+        if (pagerbase_pageout(sim, &state->base, proc, page)) recency_remove(state, frame);
+        return;
+    }
+}
+
+/*/////////////////////////////////////////////////////////////////////
+pageupdate(Simulation *sim, const Pevent *events, long nevents)
+
+    This paging function applies each change to its recency list and
+    its list of processes waiting for a page: a process leaving a page
+    makes that page the most recently used. It then starts a pagein
+    for every waiting process and, where no frame is free, pages out
+    the least recently used page of any process, one per waiting
+    process that has no pageout on its way yet, plus a small reserve.
+
+*//////////////////////////////////////////////////////////////////////
+
+static void pageupdate(Simulation *sim, const Pevent *events, long nevents) {
+    /* Pager state */
+    const Geometry *g = sim_geometry(sim);
+    long nframes = g->procs*g->maxpages;
+    struct glru_state *state = pagerstate(sim, sizeof(struct glru_state)
+                                          + (3*nframes + PAGERBASE_INTS(g))*sizeof(int));
+    Pagerbase *b = &state->base;
+    long i;
+    int frame, proc, page, left;
+
+    // initialize on first call...
+    if (!state->initialized) {
+        state->procs = g->procs;
+        state->maxpages = g->maxpages;
+        state->next = pagerbase_init(b, g, state->data);
+        state->prev = state->next + nframes;
+        state->listed = state->prev + nframes;
+        state->head = state->tail = NONE;
+        state->initialized = 1;
+    }
+    if (!nevents) return;
+
+    /* apply the changes */
+    for (i=0; i<nevents; i++) {
+        proc = events[i].proc;
+        page = events[i].page;
+        frame = proc*state->maxpages + page;
+        switch (events[i].type) {
+        case PE_CROSS:
+            // the page left behind was in use until now...
+            left = proc*state->maxpages + b->current[proc];
+            if (state->listed[left]) recency_touch(state, left);
+            break;
+        case PE_UNLOAD:
+            // the simulator freed every page of the process...
+            for (page=0; page<state->maxpages; page++)
+                recency_remove(state, proc*state->maxpages + page);
+            break;
+        case PE_IN:
+            recency_touch(state, frame);
+            break;
+        }
+        pagerbase_event(b, events+i);
+    }
+
+    /* page in what the waiting processes need */
+    for (i=0; i<b->nwaiting; ) {
+        proc = b->waiting[i];
+        if (pagein(sim, proc, b->current[proc])) {
+            // on its way or already in...
+            b->waiting[i] = b->waiting[--b->nwaiting];
+        } else {
+            // no free frame: make one, unless enough are coming...
+            if (pagerbase_reserve(b)) glru_evict(sim, state);
+            i++;
+        }
+    }
+}
+
+const Pager glru_pager = { "glru", NULL, pageupdate };
@@ -0,0 +1,283 @@
+/*/////////////////////////////////////////////////////////////////////
+File: pager-lirs.c
+
+Project: CSCI 3753 Programming Assignment 4
+Create Date: 2026/10/16
+
+Description:
+This file contains a low inter-reference recency set (LIRS) paging
+implementation. A loop over more pages than a process holds defeats
+LRU: each page is paged out just before the loop comes back to it.
+LIRS ranks pages by the recency of their last two uses instead. Pages
+reused within a short distance are LIR pages and stay resident; the
+others are HIR pages and cycle through a few frames, so a long loop
+keeps most of its body resident and faults only on the rest.
+
+Each process has a stack S of its pages in order of use (with the LIR
+page least recently used at the bottom, and ghosts of HIR pages paged
+out), and a queue Q of its resident HIR pages. A page is used when its
+process comes to it. A use of an HIR page still in S (resident or not)
+makes it LIR, and the LIR page at the bottom of S becomes HIR. Like
+lru, a fault only pages out pages of its own process: the front of Q,
+else the bottom of S. The LIR set is what the process holds, less HIRS
+pages. This paging implementation can be called with
+'./simulate -pager lirs'.
+
+*//////////////////////////////////////////////////////////////////////
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "simulator.h"
+#include "pagerlib.h"
+
+/* resident pages of a process kept for HIR pages */
+#define HIRS 1
+
+/* pager state for one simulation (see pagerstate()); the arrays
+   are carved from data[], with one entry per process page, and
+   one per process for the lists and counts */
+struct lirs_state {
+    int initialized;
+    int procs, maxpages;
+    Pagerbase base; // waiting processes and pageouts on their way
+
+    // stack S of each process, least recent (bottom) first, and
+    // queue Q of its resident HIR pages, as doubly linked lists of
+    // proc*maxpages+page...
+    int *shead, *stail, *snext, *sprev, *instack;
+    int *qhead, *qtail, *qnext, *qprev, *inqueue;
+
+    int *lir;       // LIR page (always resident)
+    int *resident;  // paged in (or coming) and not paged out
+    int *nlir, *nresident;
+
+    int data[];
+};
+
+/* a doubly linked list of process pages: the links of a page and
+   the ends of its process's list */
+static void link_remove(int *head, int *tail, int *next, int *prev, int *in, int frame) {
+    if (!in[frame]) return;
+    in[frame] = 0;
+    if (prev[frame] != NONE) next[prev[frame]] = next[frame];
+    else *head = next[frame];
+    if (next[frame] != NONE) prev[next[frame]] = prev[frame];
+    else *tail = prev[frame];
+}
+
+static void link_append(int *head, int *tail, int *next, int *prev, int *in, int frame) {
+    link_remove(head, tail, next, prev, in, frame);
+    in[frame] = 1;
+    next[frame] = NONE;
+    prev[frame] = *tail;
+    if (*tail != NONE) next[*tail] = frame;
+    else *head = frame;
+    *tail = frame;
+}
+
+static void stack_remove(struct lirs_state *state, int frame) {
+    int proc = frame / state->maxpages;
+    link_remove(state->shead+proc, state->stail+proc, state->snext, state->sprev,
+                state->instack, frame);
+}
+
+static void stack_top(struct lirs_state *state, int frame) {
+    int proc = frame / state->maxpages;
+    link_append(state->shead+proc, state->stail+proc, state->snext, state->sprev,
+                state->instack, frame);
+}
+
+static void queue_remove(struct lirs_state *state, int frame) {
+    int proc = frame / state->maxpages;
+    link_remove(state->qhead+proc, state->qtail+proc, state->qnext, state->qprev,
+                state->inqueue, frame);
+}
+
+static void queue_end(struct lirs_state *state, int frame) {
+    int proc = frame / state->maxpages;
+    link_append(state->qhead+proc, state->qtail+proc, state->qnext, state->qprev,
+                state->inqueue, frame);
+}
+
+/* drop HIR pages from the bottom of S, so that it ends in a LIR page */
+static void stack_prune(struct lirs_state *state, int proc) {
+    int frame;
+    while ((frame = state->shead[proc]) != NONE && !state->lir[frame])
+        stack_remove(state, frame);
+}
+
+/* the LIR set is over size: the LIR page at the bottom of S
+   becomes a resident HIR page */
+static void lirs_balance(struct lirs_state *state, int proc) {
+    int frame, size = state->nresident[proc] - HIRS;
+    if (size < 1) size = 1;
+    while (state->nlir[proc] > size) {
+        frame = state->shead[proc]; // LIR, as S is pruned
+        state->lir[frame] = 0;
+        state->nlir[proc]--;
+        stack_remove(state, frame);
+        queue_end(state, frame);
+        stack_prune(state, proc);
+    }
+}
+
+/* a process comes to a resident page */
+static void lirs_hit(struct lirs_state *state, int frame) {
+    int proc = frame / state->maxpages;
+    if (state->lir[frame]) {
+        stack_top(state, frame);
+        stack_prune(state, proc);
+    } else if (state->instack[frame]) {
+        // reused sooner than the bottom LIR page was...
+        state->lir[frame] = 1;
+        state->nlir[proc]++;
+        queue_remove(state, frame);
+        stack_top(state, frame);
+        lirs_balance(state, proc);
+    } else {
+        stack_top(state, frame);
+        stack_prune(state, proc);
+        queue_end(state, frame);
+    }
+}
+
+/* a page that was not resident is coming in */
+static void lirs_miss(struct lirs_state *state, int frame) {
+    int proc = frame / state->maxpages;
+    state->resident[frame] = 1;
+    state->nresident[proc]++;
+    if (state->instack[frame] || state->nlir[proc] < state->nresident[proc] - HIRS) {
+        // a ghost in S, or room in the LIR set...
+        state->lir[frame] = 1;
+        state->nlir[proc]++;
+        stack_top(state, frame);
+        lirs_balance(state, proc);
+    } else {
+        stack_top(state, frame);
+        stack_prune(state, proc);
+        queue_end(state, frame);
+    }
+}
+
+/* page out a page of the process: the front of Q, else the
+   bottom of S */
+static void lirs_evict(Simulation *sim, struct lirs_state *state, int proc) {
+    int frame = state->qhead[proc];
+    int fromq = frame != NONE;
+    if (!fromq) frame = state->shead[proc];
+    if (frame == NONE || !pagerbase_pageout(sim, &state->base, proc, frame % state->maxpages))
+        return;
+    state->resident[frame] = 0;
+    state->nresident[proc]--;
+    if (fromq) {
+        // its ghost stays in S, if it is there...
+        queue_remove(state, frame);
+    } else {
+        state->lir[frame] = 0;
+        state->nlir[proc]--;
+        stack_remove(state, frame);
+        stack_prune(state, proc);
+    }
+}
+
+/*/////////////////////////////////////////////////////////////////////
+pageupdate(Simulation *sim, const Pevent *events, long nevents)
+
+    This paging function applies each change to the stacks and queues:
+    a process coming to a resident page uses it. It then starts a
+    pagein for every waiting process, which uses the page as it comes
+    in, and where no frame is free, pages out a page of the waiting
+    process (HIR first), until a few of its pageouts are on their way.
+
+*//////////////////////////////////////////////////////////////////////
+
+static void pageupdate(Simulation *sim, const Pevent *events, long nevents) {
+    /* Pager state */
+    const Geometry *g = sim_geometry(sim);
+    long nframes = g->procs*g->maxpages;
+    struct lirs_state *state = pagerstate(sim, sizeof(struct lirs_state)
+                                          + (8*nframes + 6*g->procs + PAGERBASE_INTS(g))*sizeof(int));
+    Pagerbase *b = &state->base;
+    long i;
+    int frame, proc, page;
+
+    // initialize on first call...
+    if (!state->initialized) {
+        state->procs = g->procs;
+        state->maxpages = g->maxpages;
+        state->snext = pagerbase_init(b, g, state->data);
+        state->sprev = state->snext + nframes;
+        state->instack = state->sprev + nframes;
+        state->qnext = state->instack + nframes;
+        state->qprev = state->qnext + nframes;
+        state->inqueue = state->qprev + nframes;
+        state->lir = state->inqueue + nframes;
+        state->resident = state->lir + nframes;
+        state->shead = state->resident + nframes;
+        state->stail = state->shead + g->procs;
+        state->qhead = state->stail + g->procs;
+        state->qtail = state->qhead + g->procs;
+        state->nlir = state->qtail + g->procs;
+        state->nresident = state->nlir + g->procs;
+        for (proc=0; proc<g->procs; proc++) {
+            state->shead[proc] = state->stail[proc] = NONE;
+            state->qhead[proc] = state->qtail[proc] = NONE;
+        }
+        state->initialized = 1;
+    }
+    if (!nevents) return;
+
+    /* apply the changes */
+    for (i=0; i<nevents; i++) {
+        proc = events[i].proc;
+        page = events[i].page;
+        frame = proc*state->maxpages + page;
+        switch (events[i].type) {
+        case PE_CROSS:
+            if (state->resident[frame]) lirs_hit(state, frame);
+            break;
+        case PE_UNLOAD:
+            // the simulator freed every page of the process...
+            for (page=0; page<state->maxpages; page++) {
+                frame = proc*state->maxpages + page;
+                stack_remove(state, frame);
+                queue_remove(state, frame);
+                state->lir[frame] = state->resident[frame] = 0;
+            }
+            state->nlir[proc] = state->nresident[proc] = 0;
+            break;
+        case PE_CANCEL:
+            // it never came in...
+            if (!state->resident[frame]) break;
+            state->resident[frame] = 0;
+            state->nresident[proc]--;
+            queue_remove(state, frame);
+            if (state->lir[frame]) {
+                state->lir[frame] = 0;
+                state->nlir[proc]--;
+                stack_remove(state, frame);
+                stack_prune(state, proc);
+            }
+            break;
+        }
+        pagerbase_event(b, events+i);
+    }
+
+    /* page in what the waiting processes need */
+    for (i=0; i<b->nwaiting; ) {
+        proc = b->waiting[i];
+        frame = proc*state->maxpages + b->current[proc];
+        if (pagein(sim, proc, b->current[proc])) {
+            // on its way or already in...
+            if (!state->resident[frame]) lirs_miss(state, frame);
+            b->waiting[i] = b->waiting[--b->nwaiting];
+        } else {
+            // no free frame: make one, unless enough are coming...
+            if (pagerbase_ahead(b, proc)) lirs_evict(sim, state, proc);
+            i++;
+        }
+    }
+}
+
+const Pager lirs_pager = { "lirs", NULL, pageupdate };
@@ -21,7 +21,7 @@ for the longest time, targeting the result for eviction.
 The block comments loosely define the pieces of logic seen in the README
 file's paging diagrams. Refer to these diagrams to visualize what is 
 happening in this code. This paging implementation can be called with 
-'./test-lru' after compilation.
+'./simulate -pager lru' after compilation.
 
 *//////////////////////////////////////////////////////////////////////
 
@@ -30,8 +30,17 @@ happening in this code. This paging implementation can be called with
 
 #include "simulator.h"
 
+/* pager state for one simulation (see pagerstate()) */
+struct lru_state {
+    int initialized;
+    int tick; // artificial time
+
+    // track each processes last access time...
+    int timestamps[MAXPROCESSES][MAXPROCPAGES];
+};
+
 /*/////////////////////////////////////////////////////////////////////
-pageit(Pentry q[MAXPROCESSES])
+pageit(Simulation *sim, Pentry q[MAXPROCESSES])
 
     This paging function handles the logic behind the least recently 
     used (LRU) paging algorithm. It tracks the timestamps of operations
@@ -51,13 +60,9 @@ pageit(Pentry q[MAXPROCESSES])
 
 *//////////////////////////////////////////////////////////////////////
 
-void pageit(Pentry q[MAXPROCESSES]) { 
-    /* Static vars */
-    static int initialized = 0;
-    static int tick = 1; // artificial time
-
-    // track each processes last access time...
-    static int timestamps[MAXPROCESSES][MAXPROCPAGES];
+static void pageit(Simulation *sim, Pentry q[MAXPROCESSES]) { 
+    /* Pager state */
+    struct lru_state *state = pagerstate(sim, sizeof(struct lru_state));
 
     /* LRU Paging Algorithm */
     // initialize placeholders for process, program counter and page...
@@ -66,16 +71,17 @@ void pageit(Pentry q[MAXPROCESSES]) {
     int page;
 
     // initialize on first iteration...
-    if(!initialized) {
+    if(!state->initialized) {
         // iterate through indices of each process...
         for(proc=0; proc < MAXPROCESSES; proc++) {
             // iterate through indices of each page...
             for(page=0; page < MAXPROCPAGES; page++) {
                 // for each process/page, set access time to 0...
-                timestamps[proc][page] = 0; 
+                state->timestamps[proc][page] = 0; 
             }
         }
-        initialized = 1;
+        state->tick = 1;
+        state->initialized = 1;
     }
 
     // initialize old, least recently used pages and old tick index...
@@ -99,9 +105,9 @@ void pageit(Pentry q[MAXPROCESSES]) {
             if (!q[proc].pages[page]) {
                 /* call pagein() */
                 // attempt paging in target page...
-                if (!pagein(proc, page)) {
+                if (!pagein(sim, proc, page)) {
                     /* select a page to evict */
-                    lru_tick = tick;
+                    lru_tick = state->tick;
                     lru_page = -1;
 
                     // on page fault, iterate pages to find LRU for eviction...
@@ -110,8 +116,8 @@ void pageit(Pentry q[MAXPROCESSES]) {
                         // if page is in memory...
                         if (q[proc].pages[curr_page]) {
                             // iteratively find the oldest tick/page...
-                            if (timestamps[proc][curr_page] < lru_tick) {
-                                lru_tick = timestamps[proc][curr_page];
+                            if (state->timestamps[proc][curr_page] < lru_tick) {
+                                lru_tick = state->timestamps[proc][curr_page];
                                 lru_page = curr_page;
                             }
                         }
@@ -119,7 +125,7 @@ void pageit(Pentry q[MAXPROCESSES]) {
                     /* call pageout */
                     // swap out LRU page (if found)...
                     if (lru_page != -1) {
-                        int success = pageout(proc, lru_page);
+                        int success = pageout(sim, proc, lru_page);
                         if (!success) {
                             exit(EXIT_FAILURE);
                         }
@@ -127,9 +133,11 @@ void pageit(Pentry q[MAXPROCESSES]) {
                 }
             }
             // update timestamp for the referenced page...
-            timestamps[proc][page] = tick;
+            state->timestamps[proc][page] = state->tick;
         }
-        // advance time for next iteration...
-        tick++;
     }
-} 
+    // advance time once per call, so a tick is a tick...
+    state->tick++;
+}
+
+const Pager lru_pager = { "lru", pageit, NULL };
@@ -0,0 +1,163 @@
+/*/////////////////////////////////////////////////////////////////////
+File: pager-opt.c
+
+Project: CSCI 3753 Programming Assignment 4
+Create Date: 2026/10/16
+
+Description:
+This file contains Belady's optimal (OPT, or MIN) paging implementation.
+It cannot be built into a real system: it asks the simulator, through
+sim_nextuse(), when each process will next need each of its pages. The
+simulator knows because every branch a job takes is drawn when it is
+queued, so no pager can see a better future than this one.
+
+When a process needs a page and no frame is free, the resident page
+needed furthest in the future (or never again) is paged out, counting
+in compute ticks of the process that owns it. It gives the
+blocked/compute ratio that the other pagers can be measured against,
+e.g. with './simulate -pager lru,predict,opt'.
+
+*//////////////////////////////////////////////////////////////////////
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "simulator.h"
+#include "pagerlib.h"
+
+/* pager state for one simulation (see pagerstate()); the arrays
+   are carved from data[], with one entry per process page */
+struct opt_state {
+    int initialized;
+    int procs, maxpages;
+    long lookahead; // ticks ahead a page is fetched
+    Pagerbase base; // waiting processes and pageouts on their way
+
+    // pages in memory, and pageins started...
+    int *resident;
+    int *coming;
+
+    int data[];
+};
+
+/* page out the resident page needed furthest in the future,
+   if it is needed later than after ticks from now */
+static void opt_evict(Simulation *sim, struct opt_state *state, long after) {
+    int frame, proc, page, victim = NONE;
+    long next, furthest = after;
+    for (frame=0; frame<state->procs*state->maxpages; frame++) {
+        if (!state->resident[frame]) continue;
+        proc = frame / state->maxpages;
+        page = frame % state->maxpages;
+        if (state->base.current[proc] == page) continue;
+        next = sim_nextuse(sim, proc, page);
+        if (next < 0) {
+            // never needed again: nothing is further...
+            victim = frame;
+            break;
+        }
+        if (next > furthest) {
+            furthest = next;
+            victim = frame;
+        }
+    }
+    if (victim == NONE) return; // all needed sooner
+    if (pagerbase_pageout(sim, &state->base, victim / state->maxpages, victim % state->maxpages))
+        state->resident[victim] = 0;
+}
+
+/*/////////////////////////////////////////////////////////////////////
+pageupdate(Simulation *sim, const Pevent *events, long nevents)
+
+    This paging function keeps the same books as the fifo pager:
+    which pages are in memory or on their way in, besides those of
+    pagerlib.c. It then starts a pagein for
+    every waiting process and, where no frame is free, evicts the
+    page whose next use is furthest away, one per waiting process
+    that has no pageout on its way yet.
+
+    Knowing the future, it also fetches the page each process moves
+    to next once the move is less than lookahead ticks away, making
+    room only with a page that is needed later than that one.
+
+*//////////////////////////////////////////////////////////////////////
+
+static void pageupdate(Simulation *sim, const Pevent *events, long nevents) {
+    /* Pager state */
+    const Geometry *g = sim_geometry(sim);
+    long nframes = g->procs*g->maxpages;
+    struct opt_state *state = pagerstate(sim, sizeof(struct opt_state)
+                                         + (2*nframes + PAGERBASE_INTS(g))*sizeof(int));
+    Pagerbase *b = &state->base;
+    long i, next, want, nextpage;
+    int frame, proc, page;
+
+    // initialize on first call...
+    if (!state->initialized) {
+        state->procs = g->procs;
+        state->maxpages = g->maxpages;
+        state->lookahead = 2*g->pagewait;
+        state->resident = pagerbase_init(b, g, state->data);
+        state->coming = state->resident + nframes;
+        state->initialized = 1;
+    }
+    if (!nevents) return;
+
+    /* apply the changes */
+    for (i=0; i<nevents; i++) {
+        proc = events[i].proc;
+        page = events[i].page;
+        frame = proc*state->maxpages + page;
+        switch (events[i].type) {
+        case PE_UNLOAD:
+            // the simulator freed every page of the process...
+            for (page=0; page<state->maxpages; page++) {
+                frame = proc*state->maxpages + page;
+                state->resident[frame] = 0;
+                state->coming[frame] = 0;
+            }
+            break;
+        case PE_IN:
+            state->resident[frame] = 1;
+            state->coming[frame] = 0;
+            break;
+        case PE_CANCEL:
+            // a prefetch given up for a demand fault...
+            state->coming[frame] = 0;
+            break;
+        }
+        pagerbase_event(b, events+i);
+    }
+
+    /* page in what the waiting processes need */
+    for (i=0; i<b->nwaiting; ) {
+        proc = b->waiting[i];
+        frame = proc*state->maxpages + b->current[proc];
+        if (pagein(sim, proc, b->current[proc])) {
+            // on its way or already in...
+            if (!state->resident[frame]) state->coming[frame] = 1;
+            b->waiting[i] = b->waiting[--b->nwaiting];
+        } else {
+            // no free frame: make one, unless enough are coming...
+            if (b->ngoing < b->nwaiting) opt_evict(sim, state, 0);
+            i++;
+        }
+    }
+
+    /* fetch what the processes need next */
+    want = b->nwaiting;
+    for (proc=0; proc<state->procs; proc++) {
+        if (b->current[proc] == NONE) continue;
+        next = sim_nextpage(sim, proc, &nextpage);
+        if (next < 0 || next > state->lookahead) continue;
+        frame = proc*state->maxpages + nextpage;
+        if (state->resident[frame] || state->coming[frame] || b->going[frame]) continue;
+        if (pagein(sim, proc, nextpage)) {
+            state->coming[frame] = 1;
+        } else if (b->ngoing < ++want) {
+            opt_evict(sim, state, next);
+        }
+    }
+}
+
+const Pager opt_pager = { "opt", NULL, pageupdate };
@@ -0,0 +1,269 @@
+/*/////////////////////////////////////////////////////////////////////
+File: pager-pff.c
+
+Project: CSCI 3753 Programming Assignment 4
+Create Date: 2026/10/16
+
+Description:
+This file contains a page fault frequency (PFF) paging implementation.
+With the other local pagers a process holds whatever frames it took
+before none were free; here each process has a frame quota, set by how
+often it faults. Its fault rate is the number of its faults in the
+last WINDOW ticks of its compute (sim_runtime()). A fault above HIGH
+grows its quota by a frame, taken from the quota of the process that
+faults least when memory is all given out; a fault below LOW shrinks
+it. Memory goes to the processes that fault, away from those that
+have what they need.
+
+Quotas are enforced where a page is paged out, so free frames are
+used by whoever faults. Each process has its resident pages as a
+list, least recently used first (a page is used when its process
+leaves it). A fault with no free frame pages out the least recently
+used page of its own process when it is at quota; under quota, that
+of a process over its quota, else its own. This paging implementation
+can be called with './simulate -pager pff'.
+
+*//////////////////////////////////////////////////////////////////////
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "simulator.h"
+#include "pagerlib.h"
+
+/* fault rate: faults in the last WINDOW compute ticks; a quota
+   grows above HIGH and shrinks below LOW, but not under MINQUOTA */
+#define WINDOW 1000
+#define HIGH 8
+#define LOW 2
+#define MINQUOTA 2
+
+/* pager state for one simulation (see pagerstate()); the arrays
+   are carved from data[], with one entry per process page, and
+   one per process (HIGH+1 per process for the fault times) */
+struct pff_state {
+    int initialized;
+    int procs, maxpages, frames;
+    int nquota;     // sum of the quotas of the loaded processes
+    Pagerbase base; // waiting processes and pageouts on their way
+
+    // resident pages of each process, least recently used first,
+    // as doubly linked lists of proc*maxpages+page...
+    int *head, *tail, *size;
+    int *next, *prev;
+    int *listed;
+
+    // frames each process may hold, and its last faults (a ring of
+    // compute ticks, newest at faultat[proc*(HIGH+1)+lastfault])...
+    int *active, *quota;
+    int *faultat, *lastfault, *nfaults;
+
+    int data[];
+};
+
+static void recency_remove(struct pff_state *state, int frame) {
+    int proc = frame / state->maxpages;
+    if (!state->listed[frame]) return;
+    state->listed[frame] = 0;
+    state->size[proc]--;
+    if (state->prev[frame] != NONE) state->next[state->prev[frame]] = state->next[frame];
+    else state->head[proc] = state->next[frame];
+    if (state->next[frame] != NONE) state->prev[state->next[frame]] = state->prev[frame];
+    else state->tail[proc] = state->prev[frame];
+}
+
+/* make a resident page the most recently used of its process */
+static void recency_touch(struct pff_state *state, int frame) {
+    int proc = frame / state->maxpages;
+    recency_remove(state, frame);
+    state->listed[frame] = 1;
+    state->size[proc]++;
+    state->next[frame] = NONE;
+    state->prev[frame] = state->tail[proc];
+    if (state->tail[proc] != NONE) state->next[state->tail[proc]] = frame;
+    else state->head[proc] = frame;
+    state->tail[proc] = frame;
+}
+
+/* page out the least recently used page of a process; the page
+   it runs on, or one still coming in, goes to the recent end
+   (there are at most two of those to pass over) */
+static int pff_evict(Simulation *sim, struct pff_state *state, int proc) {
+    int frame, page, seen;
+    for (seen=0; seen<3 && state->head[proc] != NONE; seen++) {
+        frame = state->head[proc];
+        page = frame % state->maxpages;
+        if (page != state->base.current[proc]
+         && pagerbase_pageout(sim, &state->base, proc, page)) {
+            recency_remove(state, frame);
+            return 1;
+        }
+        recency_touch(state, frame);
+    }
+    return 0;
+}
+
+/* faults of a process in its last WINDOW compute ticks */
+static int pff_rate(Simulation *sim, struct pff_state *state, int proc) {
+    long now = sim_runtime(sim, proc);
+    int *at = state->faultat + proc*(HIGH+1);
+    int i, k, n = 0;
+    for (i=0, k=state->lastfault[proc]; i<state->nfaults[proc]; i++, k=(k+HIGH)%(HIGH+1)) {
+        if (at[k] < now - WINDOW) break;
+        n++;
+    }
+    return n;
+}
+
+/* the loaded process, other than proc, that faults least and
+   can give up a frame of its quota, or NONE */
+static int pff_donor(Simulation *sim, struct pff_state *state, int proc) {
+    int p, rate, best = NONE, bestrate = 0;
+    for (p=0; p<state->procs; p++) {
+        if (p == proc || !state->active[p] || state->quota[p] <= MINQUOTA) continue;
+        rate = pff_rate(sim, state, p);
+        if (best == NONE || rate < bestrate) {
+            best = p;
+            bestrate = rate;
+        }
+    }
+    return best;
+}
+
+/* a process faults: count it, and move its quota by its rate */
+static void pff_fault(Simulation *sim, struct pff_state *state, int proc) {
+    int *at = state->faultat + proc*(HIGH+1);
+    int rate, donor;
+    state->lastfault[proc] = (state->lastfault[proc]+1) % (HIGH+1);
+    at[state->lastfault[proc]] = sim_runtime(sim, proc);
+    if (state->nfaults[proc] <= HIGH) state->nfaults[proc]++;
+    rate = pff_rate(sim, state, proc);
+    if (rate > HIGH && state->quota[proc] < state->maxpages) {
+        // faulting too often: one more frame, from the process
+        // that faults least if all are given out...
+        if (state->nquota >= state->frames) {
+            donor = pff_donor(sim, state, proc);
+            if (donor == NONE) return;
+            state->quota[donor]--;
+            state->nquota--;
+        }
+        state->quota[proc]++;
+        state->nquota++;
+    } else if (rate < LOW && state->quota[proc] > MINQUOTA) {
+        // has what it needs: give a frame back, to be taken by
+        // the next fault under quota...
+        state->quota[proc]--;
+        state->nquota--;
+    }
+}
+
+/*/////////////////////////////////////////////////////////////////////
+pageupdate(Simulation *sim, const Pevent *events, long nevents)
+
+    This paging function applies each change to the recency lists,
+    quotas and list of processes waiting for a page: a fault moves the
+    quota of its process by its fault rate. It then starts a pagein
+    for every waiting process and, where no frame is free, pages out
+    the least recently used page of a process over its quota (when
+    the waiting one is under its own, and few pageouts are on their
+    way), else of the waiting process, until a few of its pageouts
+    are on their way.
+
+*//////////////////////////////////////////////////////////////////////
+
+static void pageupdate(Simulation *sim, const Pevent *events, long nevents) {
+    /* Pager state */
+    const Geometry *g = sim_geometry(sim);
+    long nframes = g->procs*g->maxpages;
+    struct pff_state *state = pagerstate(sim, sizeof(struct pff_state)
+                                         + (3*nframes + (8+HIGH)*g->procs
+                                            + PAGERBASE_INTS(g))*sizeof(int));
+    Pagerbase *b = &state->base;
+    long i;
+    int frame, proc, page, left, donor;
+
+    // initialize on first call...
+    if (!state->initialized) {
+        state->procs = g->procs;
+        state->maxpages = g->maxpages;
+        state->frames = g->frames;
+        state->next = pagerbase_init(b, g, state->data);
+        state->prev = state->next + nframes;
+        state->listed = state->prev + nframes;
+        state->head = state->listed + nframes;
+        state->tail = state->head + g->procs;
+        state->size = state->tail + g->procs;
+        state->active = state->size + g->procs;
+        state->quota = state->active + g->procs;
+        state->lastfault = state->quota + g->procs;
+        state->nfaults = state->lastfault + g->procs;
+        state->faultat = state->nfaults + g->procs;
+        for (proc=0; proc<g->procs; proc++) state->head[proc] = state->tail[proc] = NONE;
+        state->initialized = 1;
+    }
+    if (!nevents) return;
+
+    /* apply the changes */
+    for (i=0; i<nevents; i++) {
+        proc = events[i].proc;
+        page = events[i].page;
+        frame = proc*state->maxpages + page;
+        switch (events[i].type) {
+        case PE_CROSS:
+            // the page left behind was in use until now...
+            left = proc*state->maxpages + b->current[proc];
+            if (state->listed[left]) recency_touch(state, left);
+            break;
+        case PE_LOAD:
+            // a fair share to start with...
+            state->active[proc] = 1;
+            state->quota[proc] = state->frames / state->procs;
+            if (state->quota[proc] < MINQUOTA) state->quota[proc] = MINQUOTA;
+            state->nquota += state->quota[proc];
+            state->nfaults[proc] = state->lastfault[proc] = 0;
+            break;
+        case PE_FAULT:
+            pff_fault(sim, state, proc);
+            break;
+        case PE_UNLOAD:
+            // the simulator freed every page of the process...
+            for (page=0; page<state->maxpages; page++)
+                recency_remove(state, proc*state->maxpages + page);
+            state->active[proc] = 0;
+            state->nquota -= state->quota[proc];
+            break;
+        case PE_IN:
+            recency_touch(state, frame);
+            break;
+        case PE_CANCEL:
+            recency_remove(state, frame);
+            break;
+        }
+        pagerbase_event(b, events+i);
+    }
+
+    /* page in what the waiting processes need */
+    for (i=0; i<b->nwaiting; ) {
+        proc = b->waiting[i];
+        frame = proc*state->maxpages + b->current[proc];
+        if (pagein(sim, proc, b->current[proc])) {
+            // on its way or already in...
+            if (!state->listed[frame]) recency_touch(state, frame);
+            b->waiting[i] = b->waiting[--b->nwaiting];
+            continue;
+        }
+        // no free frame: under quota, a frame from a process over
+        // its own, else one of its own unless enough are coming...
+        donor = state->procs;
+        if (state->size[proc] < state->quota[proc] && pagerbase_reserve(b))
+            for (donor=0; donor<state->procs; donor++)
+                if (state->active[donor] && state->size[donor] > state->quota[donor]
+                 && pff_evict(sim, state, donor))
+                    break;
+        if (donor == state->procs && pagerbase_ahead(b, proc))
+            pff_evict(sim, state, proc);
+        i++;
+    }
+}
+
+const Pager pff_pager = { "pff", NULL, pageupdate };
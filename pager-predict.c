@@ -23,7 +23,7 @@ provides similar rates while maintaining quick performance.
 A dynamic programming approach was partially implemented and tested
 poorly in preliminary tests. I still believe this would be the best 
 approach, but may be too complicated for this application. This paging
-implementation can be called with './test-predict'.
+implementation can be called with './simulate -pager predict'.
 
 *//////////////////////////////////////////////////////////////////////
 
@@ -36,6 +36,28 @@ implementation can be called with './test-predict'.
 typedef int TimeStamps[MAXPROCESSES][MAXPROCPAGES];
 typedef int TransitionTable[MAXPROCESSES][MAXPROCPAGES][MAXPROCPAGES];
 
+// pager state for one simulation (see pagerstate())...
+struct predict_state {
+    int initialized;
+    int tick; // artificial time
+
+    // track each processes last access time (LRU)...
+    TimeStamps timestamps;
+
+    // transition matrix (predictive)...
+    // each process has a probability/adjacency matrices...
+    TransitionTable transitions;
+
+    // tracks each processes current page...
+    int current_page[MAXPROCESSES];
+};
+
+// steps best_guess() looks ahead; make pagebench3 builds it with
+// -DLOOKAHEAD_STEPS=3 to time it...
+#ifndef LOOKAHEAD_STEPS
+#define LOOKAHEAD_STEPS 1
+#endif
+
 // variables/type alias for DP solution (abandoned)...
 #define MAX_STEPS 50
 typedef int DynamicProgTable[MAXPROCESSES][MAXPROCPAGES][MAXPROCPAGES][MAX_STEPS];
@@ -193,7 +215,8 @@ int best_guess(Pentry q[MAXPROCESSES], TransitionTable transition, int proc, int
 
 /*/////////////////////////////////////////////////////////////////////
 ** inactive **
-swap_page(Pentry q[MAXPROCESSES], 
+swap_page(Simulation *sim,
+            Pentry q[MAXPROCESSES], 
             TimeStamps timestamps, 
             int proc, 
             int page, 
@@ -217,7 +240,7 @@ swap_page(Pentry q[MAXPROCESSES],
 
 *//////////////////////////////////////////////////////////////////////
 
-static inline int swap_page(Pentry q[MAXPROCESSES], TimeStamps timestamps, int proc, int page, int tick) {
+static inline int swap_page(Simulation *sim, Pentry q[MAXPROCESSES], TimeStamps timestamps, int proc, int page, int tick) {
     // use LRU to evict on page fault...
     int lru_tick = tick;
     int lru_page = -1;
@@ -236,7 +259,7 @@ static inline int swap_page(Pentry q[MAXPROCESSES], TimeStamps timestamps, int p
 
     // swap out LRU page (if found)...
     if (lru_page != -1) {
-        int success = pageout(proc, lru_page);
+        int success = pageout(sim, proc, lru_page);
         if (!success) {
             return 0;
         }
@@ -246,7 +269,7 @@ static inline int swap_page(Pentry q[MAXPROCESSES], TimeStamps timestamps, int p
 }
 
 #define FIND_LRU(q, timestamps, proc, page, tick) {\
-    if (!pagein(proc, predicted_page)) {\
+    if (!pagein(sim, proc, predicted_page)) {\
         lru_tick = tick;\
         lru_page = -1;\
         for (int curr_page = 0; curr_page < q[proc].npages; curr_page++) {\
@@ -258,13 +281,13 @@ static inline int swap_page(Pentry q[MAXPROCESSES], TimeStamps timestamps, int p
             }\
         }\
         if (lru_page != -1) {\
-            pageout(proc, lru_page);\
+            pageout(sim, proc, lru_page);\
         }\
     }\
 }
 
 /*/////////////////////////////////////////////////////////////////////
-pageit(Pentry q[MAXPROCESSES])
+pageit(Simulation *sim, Pentry q[MAXPROCESSES])
 
     This paging function handles the logic behind the predictive paging
     algorithm. It builds prediction into the previous LRU implementation.
@@ -285,20 +308,9 @@ pageit(Pentry q[MAXPROCESSES])
 
 *//////////////////////////////////////////////////////////////////////
 
-void pageit(Pentry q[MAXPROCESSES]) { 
-    /* Static vars */
-    static int initialized = 0;
-    static int tick = 1; // artificial time
-
-    // track each processes last access time (LRU)...
-    static int timestamps[MAXPROCESSES][MAXPROCPAGES];
-
-    // transition matrix (predictive)...
-    // each process has a probability/adjacency matrices...
-    static TransitionTable transitions;
-
-    // tracks each processes current page...
-    static int current_page[MAXPROCESSES];
+static void pageit(Simulation *sim, Pentry q[MAXPROCESSES]) { 
+    /* Pager state */
+    struct predict_state *state = pagerstate(sim, sizeof(struct predict_state));
 
     /* Local vars */
     // initialize placeholders for process, program counter and page...
@@ -307,23 +319,24 @@ void pageit(Pentry q[MAXPROCESSES]) {
     int page;
 
     // initialize on first iteration...
-    if (!initialized) {
+    if (!state->initialized) {
         // iterate through indices of each process...
         for (proc=0; proc<MAXPROCESSES; proc++) {
             // set all to -1; no active processes yet...
-            current_page[proc] = -1;
+            state->current_page[proc] = -1;
 
             for (page=0; page<MAXPROCPAGES; page++) {
                 // for each process/page, set access time to 0...
-                timestamps[proc][page] = 0; 
+                state->timestamps[proc][page] = 0; 
 
                 // initialize all markov probabilities to 0...
                 for (int next_page=0; next_page<MAXPROCPAGES; next_page++) {
-                    transitions[proc][page][next_page] = 0;
+                    state->transitions[proc][page][next_page] = 0;
                 }
             }
         }
-        initialized = 1;
+        state->tick = 1;
+        state->initialized = 1;
     }
 
     // initialize old, least recently used pages and old tick index...
@@ -344,23 +357,23 @@ void pageit(Pentry q[MAXPROCESSES]) {
             page = pc / PAGESIZE;
 
             // checks whether current process has been called before...
-            if (current_page[proc] != -1) {
+            if (state->current_page[proc] != -1) {
                 // increment transition between current page and target page...
-                transitions[proc][current_page[proc]][page]++;
+                state->transitions[proc][state->current_page[proc]][page]++;
             }
             // update current processes's page index...
-            current_page[proc] = page;
+            state->current_page[proc] = page;
 
             /* predict the next page */
             // when max_step==1; this only predicts a single step ahead...
-            predicted_page = best_guess(q, transitions, proc, page, 1);
+            predicted_page = best_guess(q, state->transitions, proc, page, LOOKAHEAD_STEPS);
 
             /* load predicted page if not in memory */
             if (predicted_page != -1 && !q[proc].pages[predicted_page]) {
                 // attempt paging in target page...
-                if (!pagein(proc, predicted_page)) {
+                if (!pagein(sim, proc, predicted_page)) {
                     // use LRU to evict on page fault...
-                    lru_tick = tick;
+                    lru_tick = state->tick;
                     lru_page = -1;
 
                     // on paging fail, iterate pages to find LRU for eviction...
@@ -368,27 +381,27 @@ void pageit(Pentry q[MAXPROCESSES]) {
                         // if page is in memory...
                         if (q[proc].pages[curr_page] && curr_page != page) {
                             // iteratively find the oldest tick/page...
-                            if (timestamps[proc][curr_page] < lru_tick) {
-                                lru_tick = timestamps[proc][curr_page];
+                            if (state->timestamps[proc][curr_page] < lru_tick) {
+                                lru_tick = state->timestamps[proc][curr_page];
                                 lru_page = curr_page;
                             }
                         }
                     }
 
                     if (lru_page != -1) {
-                        pageout(proc, lru_page);
+                        pageout(sim, proc, lru_page);
                     }
                 }
                 // attempted inline func/macro, degraded performance...
-                //FIND_LRU(q,timestamps,proc,predicted_page,tick);
+                //FIND_LRU(q,state->timestamps,proc,predicted_page,state->tick);
             }
 
             /* Handle current page if not in memory */
             if (!q[proc].pages[page]) {
                 // attempt paging in target page...
-                if (!pagein(proc, page)) {
+                if (!pagein(sim, proc, page)) {
                     // use LRU to evict on page fault...
-                    lru_tick = tick;
+                    lru_tick = state->tick;
                     lru_page = -1;
 
                     // on paging fail, iterate pages to find LRU for eviction...
@@ -396,24 +409,26 @@ void pageit(Pentry q[MAXPROCESSES]) {
                         // if page is in memory...
                         if (q[proc].pages[curr_page] && curr_page != page) {
                             // iteratively find the oldest tick/page...
-                            if (timestamps[proc][curr_page] < lru_tick) {
-                                lru_tick = timestamps[proc][curr_page];
+                            if (state->timestamps[proc][curr_page] < lru_tick) {
+                                lru_tick = state->timestamps[proc][curr_page];
                                 lru_page = curr_page;
                             }
                         }
                     }
 
                     if (lru_page != -1) {
-                        pageout(proc, lru_page);
+                        pageout(sim, proc, lru_page);
                     }
                 }
             }
 
             /* Update LRU timestamp */
-            timestamps[proc][page] = tick;
+            state->timestamps[proc][page] = state->tick;
         }
     }
 
     /* Advance time for next iteration */
-    tick++;
-}
\ No newline at end of file
+    state->tick++;
+}
+
+const Pager predict_pager = { "predict", pageit, NULL };
@@ -0,0 +1,278 @@
+/*/////////////////////////////////////////////////////////////////////
+File: pager-ws.c
+
+Project: CSCI 3753 Programming Assignment 4
+Create Date: 2026/10/16
+
+Description:
+This file contains a working set paging implementation with load
+control. When the processes together need more pages than there are
+frames, every other pager in the repo thrashes: each fault takes a
+page some running process is about to need. This one estimates the
+working set WS(TAU) of each process, the pages it has run on in its
+last TAU ticks of compute (sim_runtime()), and suspends a process
+(sim_suspend()) when the working sets of those running no longer fit;
+it resumes it once they do. Suspended ticks count as blocked, so it
+wins only by making the processes that do run fault less.
+
+Each running process has its working set as a list of its resident
+pages, least recently used first. Pages that fall out of it, and the
+pages of suspended processes, go on one list of pages free to be
+paged out; a fault takes the oldest of those. With nothing there, a
+fault takes from its own working set, unless the working sets of
+those running no longer fit in memory: then the process that faulted
+is suspended, unless it is the only one running. This paging
+implementation can be called with './simulate -pager ws'.
+
+*//////////////////////////////////////////////////////////////////////
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "simulator.h"
+#include "pagerlib.h"
+
+/* the working set window, in compute ticks of the process */
+#ifndef TAU
+#define TAU 3000
+#endif
+
+/* pager state for one simulation (see pagerstate()); the arrays
+   are carved from data[], with one entry per process page, and
+   one per process (lists: one more, for the free to go list) */
+struct ws_state {
+    int initialized;
+    int procs, maxpages, frames;
+    int nws;        // pages in the working sets of those running
+    int out;        // list of pages free to be paged out: procs
+    Pagerbase base; // waiting processes and pageouts on their way
+
+    // the working set of each process, and the pages free to go,
+    // least recently used first, as doubly linked lists of
+    // proc*maxpages+page...
+    int *head, *tail, *size;
+    int *next, *prev;
+    int *list;      // list of each page, or NONE
+    int *lastuse;   // compute ticks of its process when last on it
+
+    // loaded and suspended processes, those suspended oldest
+    // first, and the pages each needed when it was...
+    int *active, *suspended;
+    int *order;
+    int nsuspended, nrunning;
+    int *need;
+
+    int data[];
+};
+
+static void list_remove(struct ws_state *state, int frame) {
+    int l = state->list[frame];
+    if (l == NONE) return;
+    state->list[frame] = NONE;
+    state->size[l]--;
+    if (state->prev[frame] != NONE) state->next[state->prev[frame]] = state->next[frame];
+    else state->head[l] = state->next[frame];
+    if (state->next[frame] != NONE) state->prev[state->next[frame]] = state->prev[frame];
+    else state->tail[l] = state->prev[frame];
+}
+
+/* put a page at the most recently used end of list l */
+static void list_append(struct ws_state *state, int frame, int l) {
+    list_remove(state, frame);
+    state->list[frame] = l;
+    state->size[l]++;
+    state->next[frame] = NONE;
+    state->prev[frame] = state->tail[l];
+    if (state->tail[l] != NONE) state->next[state->tail[l]] = frame;
+    else state->head[l] = frame;
+    state->tail[l] = frame;
+}
+
+/* a process runs on a resident page now: into its working set */
+static void ws_use(Simulation *sim, struct ws_state *state, int proc, int page) {
+    int frame = proc*state->maxpages + page;
+    if (state->list[frame] == NONE) return;
+    state->lastuse[frame] = sim_runtime(sim, proc);
+    list_append(state, frame, proc);
+}
+
+/* pages a running process has not run on for TAU ticks leave
+   its working set */
+static void ws_trim(Simulation *sim, struct ws_state *state, int proc) {
+    long now = sim_runtime(sim, proc);
+    int frame;
+    if (state->base.current[proc] != NONE) ws_use(sim, state, proc, state->base.current[proc]);
+    while ((frame = state->head[proc]) != NONE && state->lastuse[frame] < now - TAU)
+        list_append(state, frame, state->out);
+}
+
+/* page out the oldest page free to go; pages still coming in
+   move to the recent end, at most procs of them */
+static int ws_evict(Simulation *sim, struct ws_state *state, int l) {
+    int frame, proc, page, seen;
+    for (seen=0; seen<=state->procs && state->head[l] != NONE; seen++) {
+        frame = state->head[l];
+        proc = frame / state->maxpages;
+        page = frame % state->maxpages;
+        if (page != state->base.current[proc]
+         && pagerbase_pageout(sim, &state->base, proc, page)) {
+            list_remove(state, frame);
+            return 1;
+        }
+        list_append(state, frame, l);
+    }
+    return 0;
+}
+
+/* hold a process back: its working set is free to go */
+static void ws_suspend(Simulation *sim, struct ws_state *state, int proc) {
+    if (!sim_suspend(sim, proc)) return;
+    state->need[proc] = state->size[proc] + 1;
+    while (state->head[proc] != NONE) list_append(state, state->head[proc], state->out);
+    state->suspended[proc] = 1;
+    state->order[state->nsuspended++] = proc;
+    state->nrunning--;
+    pagerbase_unwait(&state->base, proc);
+}
+
+/* let the oldest suspended process run again: its pages still in
+   memory are its working set once more */
+static void ws_resume(Simulation *sim, struct ws_state *state) {
+    int i, proc = state->order[0], frame;
+    for (i=1; i<state->nsuspended; i++) state->order[i-1] = state->order[i];
+    state->nsuspended--;
+    state->suspended[proc] = 0;
+    state->nrunning++;
+    sim_resume(sim, proc);
+    for (i=0; i<state->maxpages; i++) {
+        frame = proc*state->maxpages + i;
+        if (state->list[frame] == state->out) ws_use(sim, state, proc, i);
+    }
+    pagerbase_wait(&state->base, proc);
+}
+
+/*/////////////////////////////////////////////////////////////////////
+pageupdate(Simulation *sim, const Pevent *events, long nevents)
+
+    This paging function applies each change to the working sets and
+    its list of processes waiting for a page, then moves the pages a
+    running process has not run on for TAU ticks to the list of pages
+    free to go. It starts a pagein for every waiting process and,
+    where no frame is free, pages out the oldest page free to go, one
+    per waiting process that has no pageout on its way yet, plus a
+    small reserve. With none free to go, the waiting process is
+    suspended if the working sets overcommit memory, and otherwise
+    pages out its own least recently used page. Last, the oldest suspended
+    process is resumed while the frames free, freeing or free to go
+    hold the working set it had.
+
+*//////////////////////////////////////////////////////////////////////
+
+static void pageupdate(Simulation *sim, const Pevent *events, long nevents) {
+    /* Pager state */
+    const Geometry *g = sim_geometry(sim);
+    long nframes = g->procs*g->maxpages;
+    struct ws_state *state = pagerstate(sim, sizeof(struct ws_state)
+                                        + (4*nframes + 7*g->procs + 3
+                                           + PAGERBASE_INTS(g))*sizeof(int));
+    Pagerbase *b = &state->base;
+    long i, avail;
+    int frame, proc, page, left;
+
+    // initialize on first call...
+    if (!state->initialized) {
+        state->procs = g->procs;
+        state->maxpages = g->maxpages;
+        state->frames = g->frames;
+        state->out = g->procs;
+        state->next = pagerbase_init(b, g, state->data);
+        state->prev = state->next + nframes;
+        state->list = state->prev + nframes;
+        state->lastuse = state->list + nframes;
+        state->head = state->lastuse + nframes;
+        state->tail = state->head + g->procs+1;
+        state->size = state->tail + g->procs+1;
+        state->active = state->size + g->procs+1;
+        state->suspended = state->active + g->procs;
+        state->order = state->suspended + g->procs;
+        state->need = state->order + g->procs;
+        for (proc=0; proc<=g->procs; proc++) state->head[proc] = state->tail[proc] = NONE;
+        for (frame=0; frame<nframes; frame++) state->list[frame] = NONE;
+        state->initialized = 1;
+    }
+    if (!nevents) return;
+
+    /* apply the changes */
+    for (i=0; i<nevents; i++) {
+        proc = events[i].proc;
+        page = events[i].page;
+        frame = proc*state->maxpages + page;
+        switch (events[i].type) {
+        case PE_CROSS:
+            // the page left behind was in use until now...
+            left = b->current[proc];
+            if (left != NONE && state->list[proc*state->maxpages + left] == proc)
+                ws_use(sim, state, proc, left);
+            ws_use(sim, state, proc, page);
+            break;
+        case PE_LOAD:
+            state->active[proc] = 1;
+            state->nrunning++;
+            break;
+        case PE_UNLOAD:
+            // the simulator freed every page of the process...
+            for (page=0; page<state->maxpages; page++)
+                list_remove(state, proc*state->maxpages + page);
+            state->active[proc] = 0;
+            state->nrunning--;
+            break;
+        case PE_IN:
+            state->lastuse[frame] = sim_runtime(sim, proc);
+            list_append(state, frame, state->suspended[proc] ? state->out : proc);
+            break;
+        case PE_CANCEL:
+            list_remove(state, frame);
+            break;
+        }
+        pagerbase_event(b, events+i);
+    }
+
+    /* the working sets of the running processes */
+    state->nws = 0;
+    for (proc=0; proc<state->procs; proc++)
+        if (state->active[proc] && !state->suspended[proc]) {
+            ws_trim(sim, state, proc);
+            state->nws += state->size[proc];
+        }
+
+    /* page in what the waiting processes need */
+    for (i=0; i<b->nwaiting; ) {
+        proc = b->waiting[i];
+        if (pagein(sim, proc, b->current[proc])) {
+            // on its way or already in...
+            b->waiting[i] = b->waiting[--b->nwaiting];
+        } else if (!pagerbase_reserve(b)) {
+            // enough frames are coming free...
+            i++;
+        } else if (ws_evict(sim, state, state->out)) {
+            i++;
+        } else if (state->nrunning > 1 && state->nws + b->nwaiting > state->frames) {
+            // the working sets don't fit: hold this one back...
+            ws_suspend(sim, state, proc);
+        } else {
+            // they do: take from its own working set...
+            ws_evict(sim, state, proc);
+            i++;
+        }
+    }
+
+    /* let suspended processes run again while their working sets fit */
+    avail = sim_freeframes(sim) + b->ngoing + state->size[state->out] - b->nwaiting;
+    while (state->nsuspended > 0
+           && (state->nrunning == 0 || avail >= state->need[state->order[0]])) {
+        avail -= state->need[state->order[0]];
+        ws_resume(sim, state);
+    }
+}
+
+const Pager ws_pager = { "ws", NULL, pageupdate };
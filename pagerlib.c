@@ -0,0 +1,94 @@
+/*
+ * File: pagerlib.c
+ *
+ * Project: CSCI 3753 Programming Assignment 4
+ * Create Date: 2026/10/16
+ * Modify Date: 2026/10/16
+ * Description:
+ * 	This keeps the books common to the pageupdate() pagers:
+ *      the processes waiting for a page and the pageouts on
+ *      their way.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "simulator.h"
+#include "pagerlib.h"
+
+int *pagerbase_init(Pagerbase *b, const Geometry *g, int *data) {
+    int proc;
+    b->procs = g->procs;
+    b->maxpages = g->maxpages;
+    b->going = data;
+    b->current = b->going + g->procs*g->maxpages;
+    b->waiting = b->current + g->procs;
+    b->goingof = b->waiting + g->procs;
+    for (proc=0; proc<g->procs; proc++) b->current[proc] = NONE;
+    return b->goingof + g->procs;
+}
+
+/* a pageout ended, or its process exited */
+static void going_end(Pagerbase *b, int frame) {
+    if (!b->going[frame]) return;
+    b->going[frame] = 0;
+    b->ngoing--;
+    b->goingof[frame / b->maxpages]--;
+}
+
+void pagerbase_event(Pagerbase *b, const Pevent *e) {
+    int page;
+    switch (e->type) {
+    case PE_LOAD:
+    case PE_CROSS:
+    case PE_FAULT:
+        b->current[e->proc] = e->page;
+        pagerbase_wait(b, e->proc);
+        break;
+    case PE_UNLOAD:
+        // the simulator freed every page of the process...
+        for (page=0; page<b->maxpages; page++)
+            going_end(b, e->proc*b->maxpages + page);
+        b->current[e->proc] = NONE;
+        pagerbase_unwait(b, e->proc);
+        break;
+    case PE_OUT:
+        going_end(b, e->proc*b->maxpages + e->page);
+        break;
+    }
+}
+
+void pagerbase_wait(Pagerbase *b, int proc) {
+    int i;
+    for (i=0; i<b->nwaiting; i++)
+        if (b->waiting[i] == proc) return;
+    b->waiting[b->nwaiting++] = proc;
+}
+
+void pagerbase_unwait(Pagerbase *b, int proc) {
+    int i;
+    for (i=0; i<b->nwaiting; i++)
+        if (b->waiting[i] == proc) {
+            b->waiting[i] = b->waiting[--b->nwaiting];
+            return;
+        }
+}
+
+int pagerbase_pageout(Simulation *sim, Pagerbase *b, int proc, int page) {
+    int frame = proc*b->maxpages + page;
+    if (!pageout(sim, proc, page)) return 0;
+    if (!b->going[frame]) {
+        b->going[frame] = 1;
+        b->ngoing++;
+        b->goingof[proc]++;
+    }
+    return 1;
+}
+
+int pagerbase_reserve(const Pagerbase *b) {
+    return b->ngoing < b->nwaiting + b->procs/RESERVE;
+}
+
+int pagerbase_ahead(const Pagerbase *b, int proc) {
+    return b->goingof[proc] < AHEAD;
+}
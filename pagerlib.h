@@ -0,0 +1,89 @@
+/*
+ * File: pagerlib.h
+ *
+ * Project: CSCI 3753 Programming Assignment 4
+ * Create Date: 2026/10/16
+ * Modify Date: 2026/10/16
+ * Description:
+ * 	This is the bookkeeping that every pageupdate() pager
+ *      keeps apart from its policy: the page each process runs
+ *      on, the processes waiting for a page, and the pageouts
+ *      on their way. It lives in the pager's pagerstate() and
+ *      is sized by sim_geometry(), so a pager built on it runs
+ *      with any -procs and -maxpages.
+ */
+
+#define NONE (-1)
+
+/* pageouts kept going ahead of the faults. A pager that takes its
+   victims from any process keeps one per waiting process, plus
+   procs/RESERVE more: a freed frame then waits for the next fault
+   rather than the fault waiting out a whole pageout. A pager that
+   takes them from the faulting process keeps up to AHEAD of that
+   process's own, as lru's eviction on every failed pagein does. */
+#define RESERVE 2
+#define AHEAD 8
+
+struct pagerbase {
+    int procs, maxpages;
+
+    // page each process runs on (NONE if it has no process), and
+    // the processes waiting for it...
+    int *current;
+    int *waiting;
+    int nwaiting;
+
+    // pageouts started and not yet ended, by proc*maxpages+page,
+    // in all and per process...
+    int *going;
+    int ngoing;
+    int *goingof;
+};
+
+typedef struct pagerbase Pagerbase;
+
+/* ints of pagerstate() that a Pagerbase takes */
+#define PAGERBASE_INTS(g) ((g)->procs*(g)->maxpages + 3*(g)->procs)
+
+/* int *pagerbase_init(Pagerbase *b, const Geometry *g, int *data)
+ *   This sets up b in the PAGERBASE_INTS(g) ints at data,
+ *   which must be zeroed (as pagerstate() returns them).
+ * Returns:
+ *   the int after them, for the pager's own arrays
+ */
+extern int *pagerbase_init(Pagerbase *b, const Geometry *g, int *data);
+
+/* void pagerbase_event(Pagerbase *b, const Pevent *e)
+ *   This applies one change: a process that is loaded,
+ *   moves or faults waits for its page, one that exits
+ *   waits for nothing and has no pageouts left, and an
+ *   ended pageout is no longer on its way. Pagers call
+ *   it after their own handling of the change, which may
+ *   still look at the page the process was on.
+ */
+extern void pagerbase_event(Pagerbase *b, const Pevent *e);
+
+/* void pagerbase_wait(Pagerbase *b, int proc)
+ * void pagerbase_unwait(Pagerbase *b, int proc)
+ *   These add a process to the waiting processes (once),
+ *   and take it off.
+ */
+extern void pagerbase_wait(Pagerbase *b, int proc);
+extern void pagerbase_unwait(Pagerbase *b, int proc);
+
+/* int pagerbase_pageout(Simulation *sim, Pagerbase *b, int proc, int page)
+ *   This calls pageout() and counts a pageout that starts
+ *   as on its way until its PE_OUT (or PE_UNLOAD).
+ * Returns:
+ *   what pageout() returns
+ */
+extern int pagerbase_pageout(Simulation *sim, Pagerbase *b, int proc, int page);
+
+/* int pagerbase_reserve(const Pagerbase *b)
+ * int pagerbase_ahead(const Pagerbase *b, int proc)
+ *   These say whether another pageout should start: from
+ *   any process, or from proc for proc (see RESERVE and
+ *   AHEAD).
+ */
+extern int pagerbase_reserve(const Pagerbase *b);
+extern int pagerbase_ahead(const Pagerbase *b, int proc);
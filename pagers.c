@@ -0,0 +1,99 @@
+/*
+ * File: pagers.c
+ *
+ * Project: CSCI 3753 Programming Assignment 4
+ * Create Date: 2026/10/16
+ * Modify Date: 2026/10/16
+ * Description:
+ * 	This is the table of paging strategies that can be
+ *      chosen with -pager, and the loader for strategies
+ *      built as shared objects.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <dlfcn.h>
+
+#include "simulator.h"
+
+/* defined by each pager-*.c */
+extern const Pager basic_pager;
+extern const Pager lru_pager;
+extern const Pager predict_pager;
+extern const Pager api_pager;
+extern const Pager fifo_pager;
+extern const Pager opt_pager;
+extern const Pager glru_pager;
+extern const Pager clock_pager;
+extern const Pager gclock_pager;
+extern const Pager arc_pager;
+extern const Pager lirs_pager;
+extern const Pager ws_pager;
+extern const Pager pff_pager;
+
+const Pager *pagers[] = {
+    &basic_pager,
+    &lru_pager,
+    &predict_pager,
+    &api_pager,
+    &fifo_pager,
+    &opt_pager,
+    &glru_pager,
+    &clock_pager,
+    &gclock_pager,
+    &arc_pager,
+    &lirs_pager,
+    &ws_pager,
+    &pff_pager,
+    NULL
+};
+
+/* load a pager from a shared object; it is named after
+   the file, less its directory and extension */
+static const Pager *pager_load(const char *path) {
+    void *handle;
+    const Pager *found;
+    Pager *pager;
+    const char *base;
+    char *name;
+
+    handle = dlopen(path, RTLD_NOW);
+    if (!handle) {
+        fprintf(stderr, "%s\n", dlerror());
+        return NULL;
+    }
+    found = dlsym(handle, "pager");
+    if (found) return found;
+
+    pager = malloc(sizeof(Pager));
+    base = strrchr(path, '/') + 1;
+    name = strdup(base);
+    if (!pager || !name) {
+        fprintf(stderr, "%s: out of memory\n", path);
+        free(name);
+        free(pager);
+        dlclose(handle);
+        return NULL;
+    }
+    if (strchr(name, '.')) *strchr(name, '.') = '\0';
+    pager->name = name;
+    *(void **)&pager->pageit = dlsym(handle, "pageit");
+    *(void **)&pager->pageupdate = dlsym(handle, "pageupdate");
+    if (!pager->pageit && !pager->pageupdate) {
+        fprintf(stderr, "%s: defines neither pager, pageit nor pageupdate\n", path);
+        free(name);
+        free(pager);
+        dlclose(handle);
+        return NULL;
+    }
+    return pager;
+}
+
+const Pager *pager_find(const char *name) {
+    int i;
+    if (strchr(name, '/')) return pager_load(name);
+    for (i=0; pagers[i]; i++)
+        if (strcmp(pagers[i]->name, name) == 0) return pagers[i];
+    return NULL;
+}
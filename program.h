@@ -0,0 +1,60 @@
+/*
+ * File: program.h
+ *
+ * Project: CSCI 3753 Programming Assignment 4
+ * Create Date: 2026/10/16
+ * Modify Date: 2026/10/16
+ * Description:
+ * 	These are the abstract programs the simulator runs, as
+ *      defined in programs.c or compiled at run time from the
+ *      pgm*.pseudo language.
+ */
+
+#define MAXBRANCHES  40	/* number of branches in a program */
+#define MAXEXITS     10	/* number of maximum exits per program */
+
+typedef enum { GOTO, FOR, NFOR, IF } BranchType;
+
+/* abstract description of a branch
+   describes qualitative behavior, not actual branching */
+typedef struct branch {
+   long wherefrom;
+   long whereto;
+   BranchType btype;
+   long min, max;
+   double prob;
+   long extent;
+} Branch;
+
+typedef struct program {
+   long size;
+   long nbranches;
+   Branch branches[MAXBRANCHES];
+   long nexits;
+   long exits[MAXEXITS]; /* which statements are "halt" */
+} Program;
+
+/* int pseudo_load(const char *path, Program **programs, long *nprograms)
+ *   This compiles every program of a .pseudo file, each
+ *   ended by endprog, and appends them to a table that
+ *   is grown with realloc(). Errors are reported on stderr.
+ *
+ *   Each statement takes lines of the program as follows:
+ *     run n      n lines
+ *     for a b    no line; its end is a FOR branch back to the
+ *                loop, taken between a and b times
+ *     end        one line, the FOR branch
+ *     if p       one line, an IF branch that skips the body;
+ *                the body runs with probability p
+ *     else       one line, a GOTO past the else body
+ *     endif      no line after an else, else one as for else
+ *     label:     no line; names the next one
+ *     goto label one line, a GOTO
+ *     exit       one line, at which the program halts
+ * Arguments:
+ *   path: file to compile
+ *   programs, nprograms: table to append to
+ * Returns:
+ *   1 if every program compiled, 0 otherwise
+ */
+extern int pseudo_load(const char *path, Program **programs, long *nprograms);
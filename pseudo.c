@@ -0,0 +1,212 @@
+/*
+ * File: pseudo.c
+ *
+ * Project: CSCI 3753 Programming Assignment 4
+ * Create Date: 2026/10/16
+ * Modify Date: 2026/10/16
+ * Description:
+ * 	This compiles the pgm*.pseudo program language into
+ *      the Program tables that programs.c spells out by hand.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+
+#include "program.h"
+
+#define MAXLINE   256 	/* longest line of a .pseudo file */
+#define MAXNEST    32 	/* depth of nested for and if */
+#define MAXLABELS  32 	/* labels and gotos of one program */
+
+/* an open for or if */
+typedef struct block {
+    int isfor;
+    long start;         /* for: first line of the loop */
+    long min, max;      /* for: iterations */
+    long ifbranch;      /* if: its branch */
+    long elsebranch;    /* if: branch of its else, or -1 */
+} Block;
+
+/* a label, or a goto waiting for one */
+typedef struct label {
+    char name[MAXLINE];
+    long where;         /* label: line; goto: its branch */
+} Label;
+
+/* compiler state of one program */
+typedef struct compiler {
+    const char *path;
+    long line;
+    Program *p;
+    long pc;
+    Block blocks[MAXNEST];
+    long nblocks;
+    Label labels[MAXLABELS], gotos[MAXLABELS];
+    long nlabels, ngotos;
+} Compiler;
+
+static int error(Compiler *c, const char *message) {
+    fprintf(stderr, "%s:%ld: %s\n", c->path, c->line, message);
+    return 0;
+}
+
+/* append a branch at the current line */
+static long branch(Compiler *c, BranchType btype, long whereto,
+                   long min, long max, double prob) {
+    Branch *b;
+    /* process_load() requires fewer than MAXBRANCHES */
+    if (c->p->nbranches+1 >= MAXBRANCHES) return -1;
+    b = c->p->branches + c->p->nbranches;
+    b->wherefrom = c->pc++;
+    b->whereto = whereto;
+    b->btype = btype;
+    b->min = min;
+    b->max = max;
+    b->prob = prob;
+    b->extent = 0;
+    return c->p->nbranches++;
+}
+
+static int doelse(Compiler *c) {
+    Block *k = c->blocks + c->nblocks-1;
+    if ((k->elsebranch = branch(c, GOTO, 0, 0, 0, 1)) < 0)
+        return error(c, "too many branches");
+    c->p->branches[k->ifbranch].whereto = c->pc;
+    return 1;
+}
+
+/* compile one statement */
+static int statement(Compiler *c, char *s) {
+    char word[MAXLINE], arg[MAXLINE], extra[MAXLINE];
+    long n, a, b;
+    double p;
+    Block *k;
+
+    n = sscanf(s, "%s %s %s", word, arg, extra);
+    if (n<=0) return 1;
+    k = c->nblocks ? c->blocks + c->nblocks-1 : NULL;
+
+    if (strcmp(word, "run")==0) {
+        if (sscanf(s, "%*s %ld %s", &a, extra)!=1 || a<1)
+            return error(c, "expected run n");
+        c->pc += a;
+    } else if (strcmp(word, "for")==0) {
+        if (sscanf(s, "%*s %ld %ld %s", &a, &b, extra)!=2 || a<1 || b<a)
+            return error(c, "expected for min max");
+        if (c->nblocks==MAXNEST) return error(c, "nested too deeply");
+        k = c->blocks + c->nblocks++;
+        k->isfor = 1;
+        k->start = c->pc;
+        k->min = a;
+        k->max = b;
+    } else if (strcmp(word, "end")==0) {
+        if (n!=1) return error(c, "expected end");
+        if (!k || !k->isfor) return error(c, "end without for");
+        if (branch(c, FOR, k->start, k->min, k->max, 0) < 0)
+            return error(c, "too many branches");
+        c->nblocks--;
+    } else if (strcmp(word, "if")==0) {
+        if (sscanf(s, "%*s %lf %s", &p, extra)!=1 || p<0 || p>1)
+            return error(c, "expected if probability");
+        if (c->nblocks==MAXNEST) return error(c, "nested too deeply");
+        k = c->blocks + c->nblocks++;
+        k->isfor = 0;
+        k->elsebranch = -1;
+        /* the branch skips the body: taken when the body isn't run */
+        if ((k->ifbranch = branch(c, IF, 0, 0, 0, 1-p)) < 0)
+            return error(c, "too many branches");
+    } else if (strcmp(word, "else")==0) {
+        if (n!=1) return error(c, "expected else");
+        if (!k || k->isfor || k->elsebranch>=0) return error(c, "else without if");
+        return doelse(c);
+    } else if (strcmp(word, "endif")==0) {
+        if (n!=1) return error(c, "expected endif");
+        if (!k || k->isfor) return error(c, "endif without if");
+        if (k->elsebranch<0 && !doelse(c)) return 0;
+        c->p->branches[k->elsebranch].whereto = c->pc;
+        c->nblocks--;
+    } else if (strcmp(word, "goto")==0) {
+        if (n!=2) return error(c, "expected goto label");
+        if (c->ngotos==MAXLABELS) return error(c, "too many gotos");
+        strcpy(c->gotos[c->ngotos].name, arg);
+        if ((c->gotos[c->ngotos++].where = branch(c, GOTO, 0, 0, 0, 1)) < 0)
+            return error(c, "too many branches");
+    } else if (strcmp(word, "exit")==0) {
+        if (n!=1) return error(c, "expected exit");
+        if (c->p->nexits==MAXEXITS) return error(c, "too many exits");
+        c->p->exits[c->p->nexits++] = c->pc++;
+    } else if (n==1 && word[strlen(word)-1]==':') {
+        word[strlen(word)-1] = '\0';
+        for (n=0; n<c->nlabels; n++)
+            if (strcmp(c->labels[n].name, word)==0) return error(c, "label defined twice");
+        if (c->nlabels==MAXLABELS) return error(c, "too many labels");
+        strcpy(c->labels[c->nlabels].name, word);
+        c->labels[c->nlabels++].where = c->pc;
+    } else {
+        return error(c, "unknown statement");
+    }
+    return 1;
+}
+
+/* finish a program at endprog */
+static int endprog(Compiler *c) {
+    long i, j;
+    if (c->nblocks)
+        return error(c, c->blocks[c->nblocks-1].isfor ? "for without end" : "if without endif");
+    for (i=0; i<c->ngotos; i++) {
+        for (j=0; j<c->nlabels; j++)
+            if (strcmp(c->gotos[i].name, c->labels[j].name)==0) break;
+        if (j==c->nlabels) {
+            fprintf(stderr, "%s:%ld: undefined label %s\n", c->path, c->line, c->gotos[i].name);
+            return 0;
+        }
+        c->p->branches[c->gotos[i].where].whereto = c->labels[j].where;
+    }
+    if (!c->p->nexits) return error(c, "program never exits");
+    c->p->size = c->pc;
+    return 1;
+}
+
+int pseudo_load(const char *path, Program **programs, long *nprograms) {
+    char buf[MAXLINE], word[MAXLINE];
+    Compiler c;
+    Program *grown;
+    int ok = 1, open = 0;
+    FILE *f = fopen(path, "r");
+
+    if (!f) {
+        fprintf(stderr, "%s: can't open program\n", path);
+        return 0;
+    }
+    memset(&c, 0, sizeof(c));
+    c.path = path;
+    while (ok && fgets(buf, sizeof(buf), f)) {
+        c.line++;
+        if (strchr(buf, '#')) *strchr(buf, '#') = '\0';
+        if (sscanf(buf, "%s", word)!=1) continue;
+        if (!open) {
+            /* zeroed, as are the unused branches of programs.c */
+            grown = realloc(*programs, (*nprograms+1)*sizeof(Program));
+            if (!grown) {
+                fprintf(stderr, "%s: out of memory\n", path);
+                ok = 0;
+                break;
+            }
+            *programs = grown;
+            c.p = grown + *nprograms;
+            memset(c.p, 0, sizeof(Program));
+            c.pc = c.nblocks = c.nlabels = c.ngotos = 0;
+            open = 1;
+        }
+        if (strcmp(word, "endprog")==0) {
+            if ((ok = endprog(&c))) (*nprograms)++;
+            open = 0;
+        } else {
+            ok = statement(&c, buf);
+        }
+    }
+    if (ok && open) ok = error(&c, "missing endprog");
+    fclose(f);
+    return ok;
+}
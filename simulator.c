@@ -18,30 +18,16 @@
 #include <unistd.h>
 #include <stdlib.h> 
 #include <stdarg.h> 
-#include <signal.h>
 #include <time.h> 
 
 #include "simulator.h"
+#include "trace.h"
+#include "workload.h"
+#include "program.h"
+#include "stats.h"
 
-FILE *output = NULL; 	/* PC history for statistical analysis */ 
-FILE *pages = NULL; 	/* block allocation history */ 
-#define MAXPROCESSES 20 /* number of processes in parallel */ 
-#define MAXBRANCHES  40	/* number of branches in a program */ 
-#define MAXEXITS     10	/* number of maximum exits per program */ 
 #define MAXBRINGS   100	/* must be EVEN! data points in branch table */ 
 
-static long sysclock=0; 
-static long seed=0; 
-static long procs=MAXPROCESSES;
-
-#define LOG_ALWAYS  (1<<0)
-#define LOG_LOAD    (1<<1)
-#define LOG_BLOCK   (1<<2)
-#define LOG_PAGE    (1<<3)
-#define LOG_BRANCH  (1<<4)
-#define LOG_DEAD    (1<<5)
-#define LOG_QUEUE   (1<<9)
-
 #include <stdio.h>
 #include <stdarg.h> 
 #include <sys/types.h>
@@ -54,7 +40,7 @@ static long procs=MAXPROCESSES;
 #define CARP(reason) carp((reason),__FILE__,__LINE__)
 
 // always print the result of a test
-inline void check(int boolean, char *boolstr, char *file, int line) { 
+static inline void check(int boolean, char *boolstr, char *file, int line) { 
     if (!boolean) {
         fprintf(stderr,"ERROR: %s failed in line %d of file %s\n",
                 boolstr,line,file);
@@ -74,7 +60,7 @@ static inline void assert(int boolean, char *boolstr, char *file, int line) {
 }
 
 // report failing assertions without bombing out... keeps running
-inline int posit(int boolean, char *boolstr, char *file, int line) {
+static inline int posit(int boolean, char *boolstr, char *file, int line) {
     if (!boolean) 
         fprintf(stderr,"Assertion %s failed in line %d of file %s\n",
                 boolstr,line,file);
@@ -82,53 +68,18 @@ inline int posit(int boolean, char *boolstr, char *file, int line) {
 }
 
 // die on a fatal error
-inline void die(char *condition, char *file, int line) {
+static inline void die(char *condition, char *file, int line) {
     fprintf(stderr,"Fatal error: %s at line %d of file %s\n", 
         condition,line,file); 
     exit(1); 
 }
 
 // print a non-fatal error 
-inline void carp(char *condition, char *file, int line) {
+static inline void carp(char *condition, char *file, int line) {
     fprintf(stderr,"Non-fatal error: %s at line %d of file %s\n",
 	condition,line,file); 
 }
 
-static long log_port=LOG_ALWAYS;  // logging ports for output
-static void sim_log(long type, const char *format, ...) { 
-    va_list ap; 
-    if (log_port&type) { 
-	va_start(ap, format);
-	fprintf(stderr,"%08ld: ",sysclock); vfprintf(stderr,format,ap); 
-	va_end(ap);
-    } 
-} 
-
-/* keep track of physical page usage */ 
-static long pagesavail = PHYSICALPAGES; 
-
-typedef enum { GOTO, FOR, NFOR, IF } BranchType;
-
-/* abstract description of a branch 
-   describes qualitative behavior, not actual branching */ 
-typedef struct branch { 
-   long wherefrom;
-   long whereto; 
-   BranchType btype; 
-   long min, max; 
-   double prob; 
-   long extent; 
-} Branch;
-
-typedef struct program { 
-   long size; 
-   long nbranches; 
-   Branch branches[MAXBRANCHES]; 
-   long nexits; 
-   long exits[MAXEXITS]; /* which statements are "halt" */ 
-} Program; 
-
-
 // branch context: determines which branch to 
 // take next in a probabilistic situation...
 typedef struct bcontext { 
@@ -140,29 +91,217 @@ typedef struct bcontext {
    long brings[MAXBRINGS]; 
 } Bcontext; 
 
+/* what process_step() does at one pc of a program */ 
+typedef struct pcinfo { 
+   int event;                  /* PC_EXIT, PC_LINE, or the branch there */ 
+   int run;                    /* lines from here to the next event, 
+                                  or to the end of the program */ 
+} Pcinfo; 
+
+#define PC_EXIT (-1) 
+#define PC_LINE (-2) 
+
+/* dispatch table of a program: one entry for each pc from 0 
+   through size, the pcs a process of the program can reach */ 
+typedef struct dispatch { 
+   Pcinfo *pcs; 
+} Dispatch; 
+
+/* the pages a process will visit, built for sim_nextuse(): run i 
+   is on page[i] from compute tick start[i] to start[i+1]-1, and 
+   the runs on page p are runs[byfirst[p]..byfirst[p+1]-1] */ 
+typedef struct future { 
+   long nruns; 
+   long *start;                /* nruns+1 entries */ 
+   long *page; 
+   long *byfirst;              /* maxpages+1 entries */ 
+   long *runs; 
+} Future; 
+
+#define FUTURELIMIT (1L<<26) 	/* ticks looked ahead by sim_nextuse() */ 
+
 typedef struct process { 
-   Program *program; 
+   const Program *program; 
+   const Dispatch *dispatch; 	/* of program */ 
    long nbcontexts; 
    Bcontext bcontexts[MAXBRANCHES]; 
    long pc; 	            	/* program counter */ 
    long npages; 
-   long pages[MAXPROCPAGES]; 	/* whether page is available */ 
-   long blocked[MAXPROCPAGES];	/* whether we've reported page state */ 
+   long *pages; 	    	/* whether page is available */ 
+   long *blocked;	    	/* whether we've reported page state; 
+				   both are those of the processor 
+				   the process is loaded into */ 
    long active;              	/* whether running now */ 
+   long suspended;             	/* held by sim_suspend(); its ticks 
+				   count as blocked */ 
    long compute; 	    	/* number of compute ticks */ 
    long block; 		    	/* number of blocked ticks */ 
    long pid; 			/* unique process number */ 
    long kind; 			/* kind of process from table */ 
+   Pcstream *stream; 		/* recorded pcs, or NULL to run program */ 
+   Future *future; 		/* see sim_nextuse(), or NULL */ 
 } Process;
 
-static Process *processes[MAXPROCESSES]; 
+#define QUEUEREPEATS 8 	/* times each program is queued */ 
+
+/* phases of a tick timed by -timing */ 
+enum { PH_STEP, PH_AGE, PH_CALLYOU, PH_BLOCKED, PH_WARP, PHASES }; 
+static const char *phase_names[PHASES] = { 
+   "allstep", "allage", "callyou", "allblocked", "allwarp", 
+}; 
+#define LATENCYBUCKETS (64*16) 	/* 16 per power of two of ns */ 
+
+/* wall time spent by one run, for -timing */ 
+typedef struct timing { 
+   long ticks;                 /* ticks simulated (not warped over) */ 
+   long ns[PHASES];            /* in each phase */ 
+   long pagerns;               /* in pageit() and pageupdate() */ 
+   long latency[LATENCYBUCKETS]; /* of each call of the pager */ 
+} Timing; 
+#define SIMLIMIT 32767 	/* most processors or pages: traces keep 16 bits */ 
+#define IOCOST 1000 	/* -bandwidth is pages per IOCOST ticks */ 
+#define IOCAP(sim) ((sim)->bandwidth>IOCOST ? (sim)->bandwidth : IOCOST) /* credit kept */ 
+
+/* page of a pc; pcs are never negative, so a shift will do 
+   when pages are a power of two, as they are by default */ 
+#define PAGEOF(sim,pc) ((sim)->pageshift>=0 ? (pc)>>(sim)->pageshift \
+                                            : (pc)/(sim)->pagesize) 
+
+/* bitset over the page slab: which pages are coming in or going out */ 
+#define WORDBITS (8*sizeof(unsigned long)) 
+#define BITWORDS(n) (((n)+WORDBITS-1)/WORDBITS) 
+#define BITSET(set,k)   ((set)[(k)/WORDBITS] |= 1UL<<((k)%WORDBITS)) 
+#define BITTEST(set,k)  ((set)[(k)/WORDBITS] & 1UL<<((k)%WORDBITS)) 
+#define BITCLEAR(set,k) ((set)[(k)/WORDBITS] &= ~(1UL<<((k)%WORDBITS))) 
+
+/* what the page under a process's pc is doing, counted over the 
+   running processes as pages and pcs move (see allblocked()) */ 
+enum { PC_RUNNABLE, PC_MEMWAIT, PC_FREEWAIT, PC_SWAPPED, PCSTATES }; 
+#define PCSTATE(sim,stat) ((stat)==0 ? PC_RUNNABLE : (stat)>0 ? PC_MEMWAIT \
+			   : (stat)<-(sim)->pagewait ? PC_SWAPPED : PC_FREEWAIT) 
+
+/* all of the state of one simulation run; 
+   independent runs may share a process */ 
+struct simulation { 
+   const Pager *pager; 
+   long sysclock; 
+   long seed; 
+   long procs;                 /* number of processors in use */ 
+   long warp;                  /* skip ticks in which nothing can change */ 
+   long pagerbusy;             /* pageit() started a pagein or pageout */ 
+   long log_port;              /* logging ports for output */ 
+   long pagesavail;            /* keep track of physical page usage */ 
+   long *freeframes;           /* free frames, a stack of pagesavail */ 
+   long *frameslot;            /* slot page held by each frame, or -1 */ 
+   long *slotframe;            /* frame of each slot page, or -1 */ 
+   long channels;              /* swap device: transfers at once, or 0 */ 
+   long bandwidth;             /* ... pages per IOCOST ticks, or 0 */ 
+   long ioqueue;               /* ... requests that may wait, or 0 */ 
+   long inservice;             /* transfers under way (in inflight) */ 
+   long credit;                /* bandwidth earned, IOCOST a page */ 
+   long *ionext, *ioprev;      /* requests waiting for the device: a 
+				  list of slot pages, oldest first */ 
+   long *iosubmit;             /* clock each waiting request was made */ 
+   long iosched;               /* IOSCHED_*: which waiting request goes next */ 
+   long iodeadline;            /* ticks a prefetch may wait behind demand */ 
+   long iohead, iotail, nqueued; 
+   unsigned short rand[3];     /* drand48 stream for this run */ 
+   FILE *output;               /* PC history for statistical analysis */ 
+   FILE *pages;                /* block allocation history */ 
+   Tracewriter *trace;         /* binary trace of both, or NULL */ 
+   Stats *stats;               /* metrics for -stats, or NULL */ 
+   FILE *statsfile; 
+   long statscsv; 
+   long nextsample;            /* clock of the next resident set sample */ 
+   Timing *timing;             /* for -timing, or NULL */ 
+   long pageins, pageouts;     /* calls of pagein() and pageout() */ 
+   long pagesize;              /* size of an individual page */ 
+   long pageshift;             /* log2(pagesize), or -1 if not a power of 2 */ 
+   long maxpages;              /* pages per process */ 
+   long pagewait;              /* ticks to page out; pages below 
+				  -pagewait are free */ 
+   long readwait;              /* ticks to page in */ 
+   long *slotpages;            /* pages and blocked of each processor, */ 
+   long *slotblocked;          /* maxpages apiece */ 
+   unsigned long *inflight;    /* slot pages paging in or out (BITSET) */ 
+   long ninflight;             /* ... and how many */ 
+   long pcstates[PCSTATES];    /* running processes by PC_*, 
+				  less those suspended */ 
+   long nsuspended;            /* processes suspended */ 
+   long giveup;                /* ticks stuck before the run ends, or 0 */ 
+   long stuck;                 /* ticks stuck so far */ 
+   long givenup;               /* the run was ended stuck */ 
+   long *completed;            /* slot pages whose paging ended this tick */ 
+   Process **processes;        /* running on each processor */ 
+   Geometry geometry;          /* see sim_geometry() */ 
+   Process *queue;             /* job queue: queuesize processes */ 
+   long queuesize; 
+   long queueend; 
+   const Program *programs;    /* programs the queue runs */ 
+   long nprograms; 
+   Dispatch *dispatch;         /* one for each program */ 
+   const Workload *workload;   /* recorded pc streams, or NULL */ 
+   Pcstream *streams;          /* one per process of the workload */ 
+   void *pagerdata;            /* see pagerstate() */ 
+   Pevent *events;             /* changes for pageupdate() */ 
+   long nevents, maxevents; 
+}; 
+
+static void sim_log(Simulation *sim, long type, const char *format, ...) { 
+    va_list ap; 
+    if (sim->log_port&type) { 
+	va_start(ap, format);
+	fprintf(stderr,"%08ld: ",sim->sysclock); vfprintf(stderr,format,ap); 
+	va_end(ap);
+    } 
+} 
+
+/* record an event of process q in processor pnum: a TR_* event 
+   up to TR_LOAD goes to output.csv, a page event to pages.csv */ 
+static void sim_event(Simulation *sim, int event, long pnum, long page, Process *q) { 
+    if (event<=TR_LOAD) { 
+	if (sim->output) fprintf(sim->output, "%ld,%ld,%ld,%ld,%ld,%s\n", 
+	    sim->sysclock, pnum, q->pid, q->kind, q->pc, trace_names[event]); 
+    } else { 
+	if (sim->pages) fprintf(sim->pages,"%ld,%ld,%ld,%ld,%ld,%s\n",
+	    sim->sysclock, pnum, page, q->pid, q->kind, trace_names[event]); 
+    } 
+    if (sim->trace) { 
+	Tracerec r; 
+	r.clock = sim->sysclock; 
+	r.pid = q->pid; 
+	r.pc = q->pc; 
+	r.proc = pnum; 
+	r.page = event<=TR_LOAD ? -1 : page; 
+	r.kind = q->kind; 
+	r.event = event; 
+	memset(r.pad, 0, sizeof(r.pad)); 
+	trace_put(sim->trace, &r); 
+    } 
+} 
+
+/* note a change for the pager's pageupdate(), if it has one */ 
+static void sim_notify(Simulation *sim, int type, long pnum, long page, Process *q) { 
+    Pevent *e; 
+    if (!sim->pager->pageupdate) return; 
+    if (sim->nevents==sim->maxevents) { 
+	sim->maxevents = sim->maxevents ? 2*sim->maxevents : 64; 
+	sim->events = realloc(sim->events, sim->maxevents*sizeof(Pevent)); 
+	if (!sim->events) DIE("out of memory"); 
+    } 
+    e = sim->events + sim->nevents++; 
+    e->type = type; 
+    e->proc = pnum; 
+    e->page = page; 
+    e->pc = q->pc; 
+} 
 
 #include "programs.c" 
 
 /* make a binary decision according to a 
    probability distribution */ 
-static long binary(double prob) { 
-    if (drand48()<prob) return 1; 
+static long binary(Simulation *sim, double prob) { 
+    if (erand48(sim->rand)<prob) return 1; 
     else return 0; 
 } 
 
@@ -178,7 +317,7 @@ static void bcontext_clear( Bcontext *c) {
 } 
 
 /* initialize a branching engine */ 
-static void bcontext_init( Bcontext *c, Branch *b) { 
+static void bcontext_init(Simulation *sim, Bcontext *c, const Branch *b) { 
     long i; 
     c->bcount=0; 
     c->btype=b->btype; 
@@ -193,11 +332,11 @@ static void bcontext_init( Bcontext *c, Branch *b) {
         long cvalue; 
 	c->boffset=0; 
         c->bsize=0; 
-        cvalue=c->bvalue=binary(b->prob); 
+        cvalue=c->bvalue=binary(sim,b->prob); 
         c->bcount=0; 
         // compute future values for if statements 
         while (c->bsize<MAXBRINGS)  {
-	    if (binary(b->prob)==cvalue) { 
+	    if (binary(sim,b->prob)==cvalue) { 
 		c->brings[c->bsize]++; 
 	    } else { 
 		c->bsize++; 
@@ -211,7 +350,7 @@ static void bcontext_init( Bcontext *c, Branch *b) {
         c->bsize=0; 
         while (c->bsize<MAXBRINGS) { 
 	    if (b->max > b->min) { 
-		c->brings[c->bsize++]=lrand48()%(b->max-b->min)+b->min; 
+		c->brings[c->bsize++]=nrand48(sim->rand)%(b->max-b->min)+b->min; 
             } else { 
 		c->brings[c->bsize++]=b->min; 
             } 
@@ -223,7 +362,7 @@ static void bcontext_init( Bcontext *c, Branch *b) {
         c->bsize=0; 
         while (c->bsize<MAXBRINGS) { 
 	    if (b->max > b->min) { 
-		c->brings[c->bsize++]=lrand48()%(b->max-b->min)+b->min; 
+		c->brings[c->bsize++]=nrand48(sim->rand)%(b->max-b->min)+b->min; 
             } else { 
 		c->brings[c->bsize++]=b->min; 
             } 
@@ -255,277 +394,586 @@ static void process_clear(Process *q) {
    q->program = NULL; 
    q->pid = -1; 
    q->kind = -1;
+   q->stream = NULL; 
+   q->future = NULL; 
    q->nbcontexts = 0; 
    for (i=0; i<MAXBRANCHES; i++) {
        bcontext_clear(q->bcontexts+i); 
    } 
    q->npages = 0; 
-   /* no physical pages assigned */ 
-   for (i=0; i<MAXPROCPAGES; i++) {
-	q->pages[i]=-PAGEWAIT-1; 
-	q->blocked[i]=FALSE; // ALC: so simulator will log first access 
-   } 
+   /* no processor, so no pages yet */ 
+   q->pages = q->blocked = NULL; 
    q->active=FALSE; 
+   q->suspended=FALSE; 
+} 
+
+/* build the dispatch table of a program, so that process_step() 
+   and process_horizon() need not search its exits and branches */ 
+static void dispatch_build(Dispatch *d, const Program *p) { 
+   long i, pc, nbranches; 
+   ASSERT(p->nexits>=1 && p->nexits<=MAXEXITS); 
+   ASSERT(p->nbranches>=0 && p->nbranches<MAXBRANCHES); 
+   d->pcs = malloc((p->size+1)*sizeof(Pcinfo)); 
+   if (!d->pcs) DIE("out of memory"); 
+   for (pc=0; pc<=p->size; pc++) d->pcs[pc].event = PC_LINE; 
+   /* the old binary search probed branches[0] even when 
+      there were none, so a program without branches still 
+      branches at branches[0].wherefrom */ 
+   nbranches = p->nbranches ? p->nbranches : 1; 
+   for (i=nbranches-1; i>=0; i--) 
+       if (p->branches[i].wherefrom>=0 && p->branches[i].wherefrom<=p->size) 
+	   d->pcs[p->branches[i].wherefrom].event = i; 
+   /* an exit is found before a branch at the same pc */ 
+   for (i=0; i<p->nexits; i++) 
+       if (p->exits[i]>=0 && p->exits[i]<=p->size) 
+	   d->pcs[p->exits[i]].event = PC_EXIT; 
+   d->pcs[p->size].run = 0; 
+   for (pc=p->size-1; pc>=0; pc--) 
+       d->pcs[pc].run = d->pcs[pc].event==PC_LINE ? d->pcs[pc+1].run+1 : 0; 
 } 
 
 /* load a program into a process */ 
-static void process_load(Process *q, Program *p, int pid, int kind) { 
+static void process_load(Simulation *sim, Process *q, const Program *p, int pid, int kind) { 
    long i; 
    q->pc = 0; 
    q->compute=q->block=0; 
    q->program = p; 
+   q->dispatch = sim->dispatch+kind; /* kind indexes sim->programs */ 
    q->pid = pid; 
    q->kind = kind; 
    q->nbcontexts = p->nbranches; 
    ASSERT(p->nbranches>=0 && p->nbranches<MAXBRANCHES); 
    for (i=0; i<p->nbranches; i++) {
-       bcontext_init(q->bcontexts+i, p->branches+i); 
+       bcontext_init(sim,q->bcontexts+i, p->branches+i); 
    } 
-   // fprintf(stderr,"actual page size for process is %d\n", (q->program->size+PAGESIZE-1)/PAGESIZE); 
-   q->npages = MAXPROCPAGES; 
-   for (i=0; i<MAXPROCPAGES; i++) { 
-	q->pages[i]=-PAGEWAIT-1; 
+   // fprintf(stderr,"actual page size for process is %d\n", (q->program->size+sim->pagesize-1)/sim->pagesize); 
+   q->npages = sim->maxpages; /* assigned by process_place() */ 
+   q->active=TRUE; 			 /* now running */ 
+} 
+
+/* load a recorded pc stream into a process */ 
+static void process_loadstream(Simulation *sim, Process *q, long pid) { 
+   q->stream = sim->streams+pid; 
+   pcstream_init(q->stream, sim->workload, pid); 
+   q->pc = sim->workload->procs[pid].first; 
+   q->compute=q->block=0; 
+   q->pid = pid; 
+   q->kind = sim->workload->procs[pid].kind; 
+   q->npages = sim->maxpages; 
+   q->active=TRUE; 
+} 
+
+/* give a process the pages of the processor it is loaded into */ 
+static void process_place(Simulation *sim, long pnum, Process *q) { 
+   long i; 
+   q->pages = sim->slotpages + pnum*sim->maxpages; 
+   q->blocked = sim->slotblocked + pnum*sim->maxpages; 
+   /* no physical pages assigned */ 
+   for (i=0; i<q->npages; i++) { 
+	q->pages[i]=-sim->pagewait-1; 
  	q->blocked[i]=FALSE; // ALC: so simulator will log first access 
    } 
-   /* no physical pages assigned */ 
-   q->active=TRUE; 			 /* now running */ 
+} 
+
+/*==================================
+   the future of a process (oracle) 
+  ==================================*/ 
+
+static void future_free(Process *q) { 
+   if (!q->future) return; 
+   free(q->future->start); 
+   free(q->future->page); 
+   free(q->future->byfirst); 
+   free(q->future->runs); 
+   free(q->future); 
+   q->future = NULL; 
+} 
+
+/* note the page of the pc at compute tick t */ 
+static void future_visit(Future *f, long *size, long t, long page) { 
+   if (!f->nruns || f->page[f->nruns-1]!=page) { 
+       if (f->nruns+2>*size) { 
+	   *size *= 2; 
+	   f->start = realloc(f->start, *size*sizeof(long)); 
+	   f->page = realloc(f->page, *size*sizeof(long)); 
+	   if (!f->start || !f->page) DIE("out of memory"); 
+       } 
+       f->start[f->nruns] = t; 
+       f->page[f->nruns++] = page; 
+   } 
+   f->start[f->nruns] = t+1; /* end of the last run */ 
+} 
+
+/* Every random choice of a process is drawn when it is queued 
+   (see bcontext_init()), so its pcs do not depend upon paging. 
+   This replays them from where the process is now, on copies 
+   of its branch engines, as process_step() would run them. */ 
+static Future *future_build(Simulation *sim, Process *q) { 
+   long size = 64, t = q->compute, pc = q->pc, i, p; 
+   Future *f = calloc(1, sizeof(Future)); 
+   if (!f) DIE("out of memory"); 
+   f->start = malloc(size*sizeof(long)); 
+   f->page = malloc(size*sizeof(long)); 
+   if (!f->start || !f->page) DIE("out of memory"); 
+   if (q->stream) { 
+       Pcstream s; 
+       long next; 
+       /* from its first pc, t counting from zero */ 
+       pcstream_init(&s, sim->workload, q->pid); 
+       pc = sim->workload->procs[q->pid].first; 
+       for (t=0; t<FUTURELIMIT; t++) { 
+	   future_visit(f, &size, t, PAGEOF(sim, pc)); 
+	   if (!pcstream_next(&s, &next)) break; 
+	   pc = next; 
+       } 
+       pcstream_close(&s); 
+   } else { 
+       Bcontext *c = malloc(MAXBRANCHES*sizeof(Bcontext)); 
+       if (!c) DIE("out of memory"); 
+       memcpy(c, q->bcontexts, MAXBRANCHES*sizeof(Bcontext)); 
+       for (; t<q->compute+FUTURELIMIT; t++) { 
+	   int event = q->dispatch->pcs[pc].event; 
+	   future_visit(f, &size, t, PAGEOF(sim, pc)); 
+	   if (event==PC_EXIT) break; 
+	   if (event!=PC_LINE) { 
+	       if (bcontext_decide(c+event)) pc = q->program->branches[event].whereto; 
+	       else pc++; 
+	       if (pc<0 || pc>=q->program->size) pc=0; 
+	   } else { 
+	       pc++; 
+	       if (pc<0 || pc>q->program->size) pc=0; 
+	   } 
+       } 
+       free(c); 
+   } 
+   /* index the runs by page */ 
+   f->byfirst = calloc(sim->maxpages+1, sizeof(long)); 
+   f->runs = malloc((f->nruns ? f->nruns : 1)*sizeof(long)); 
+   if (!f->byfirst || !f->runs) DIE("out of memory"); 
+   for (i=0; i<f->nruns; i++) f->byfirst[f->page[i]+1]++; 
+   for (p=0; p<sim->maxpages; p++) f->byfirst[p+1] += f->byfirst[p]; 
+   { 
+       long *fill = calloc(sim->maxpages, sizeof(long)); 
+       if (!fill) DIE("out of memory"); 
+       for (i=0; i<f->nruns; i++) { 
+	   p = f->page[i]; 
+	   f->runs[f->byfirst[p] + fill[p]++] = i; 
+       } 
+       free(fill); 
+   } 
+   return f; 
+} 
+
+/* public routine: when a process leaves its page, and for which */ 
+long sim_nextpage(Simulation *sim, int process, long *page) { 
+    Process *q; 
+    Future *f; 
+    long lo, hi, now; 
+    if (process<0 || process>=sim->procs || !(q = sim->processes[process]) 
+     || !q->active) 
+	return -1; 
+    if (!q->future) q->future = future_build(sim, q); 
+    f = q->future; 
+    now = q->compute; 
+    /* first run that starts after now */ 
+    lo = 0; 
+    hi = f->nruns; 
+    while (lo<hi) { 
+	long mid = (lo+hi)/2; 
+	if (f->start[mid] <= now) lo = mid+1; 
+	else hi = mid; 
+    } 
+    if (lo==f->nruns) return -1; 
+    *page = f->page[lo]; 
+    return f->start[lo]-now; 
+} 
+
+/* public routine: compute ticks before a process needs a page */ 
+long sim_nextuse(Simulation *sim, int process, int page) { 
+    Process *q; 
+    Future *f; 
+    long lo, hi, now; 
+    if (process<0 || process>=sim->procs || !(q = sim->processes[process]) 
+     || !q->active || page<0 || page>=q->npages) 
+	return -1; 
+    if (!q->future) q->future = future_build(sim, q); 
+    f = q->future; 
+    now = q->compute; 
+    /* first run on page that ends after now */ 
+    lo = f->byfirst[page]; 
+    hi = f->byfirst[page+1]; 
+    while (lo<hi) { 
+	long mid = (lo+hi)/2; 
+	if (f->start[f->runs[mid]+1] <= now) lo = mid+1; 
+	else hi = mid; 
+    } 
+    if (lo==f->byfirst[page+1]) return -1; 
+    lo = f->start[f->runs[lo]]; 
+    return lo>now ? lo-now : 0; 
+} 
+
+/*===============================
+   physical frames 
+  ===============================*/ 
+
+/* give slot page a free frame; the caller checks pagesavail */ 
+static void frame_take(Simulation *sim, long slot) { 
+   long frame = sim->freeframes[--sim->pagesavail]; 
+   sim->frameslot[frame] = slot; 
+   sim->slotframe[slot] = frame; 
+} 
+
+/* return the frame of slot page to the free list */ 
+static void frame_free(Simulation *sim, long slot) { 
+   long frame = sim->slotframe[slot]; 
+   sim->frameslot[frame] = -1; 
+   sim->slotframe[slot] = -1; 
+   sim->freeframes[sim->pagesavail++] = frame; 
+} 
+
+/*===============================
+   swap device 
+  ===============================*/ 
+
+/* whether a transfer can start now */ 
+static int io_ready(Simulation *sim) { 
+   return (!sim->channels || sim->inservice<sim->channels) 
+       && (!sim->bandwidth || sim->credit>=IOCOST); 
+} 
+
+/* whether a new pagein must be refused: it can neither start 
+   nor wait. Pageouts are always let wait, since pagers page 
+   out to make room and expect that to succeed */ 
+static int io_full(Simulation *sim) { 
+   return sim->ioqueue && sim->nqueued>=sim->ioqueue 
+       && (sim->nqueued || !io_ready(sim)); 
+} 
+
+static void io_start(Simulation *sim, long slot) { 
+   sim->inservice++; 
+   if (sim->bandwidth) sim->credit -= IOCOST; 
+   BITSET(sim->inflight, slot); 
+} 
+
+static void io_unqueue(Simulation *sim, long slot) { 
+   long next = sim->ionext[slot], prev = sim->ioprev[slot]; 
+   if (prev<0) sim->iohead = next; else sim->ionext[prev] = next; 
+   if (next<0) sim->iotail = prev; else sim->ioprev[next] = prev; 
+   sim->nqueued--; 
+} 
+
+/* start the transfer of slot page, or queue it behind the 
+   others; returns whether it started */ 
+static int io_submit(Simulation *sim, long slot) { 
+   if (!sim->nqueued && io_ready(sim)) { 
+       io_start(sim, slot); 
+       return TRUE; 
+   } 
+   sim->iosubmit[slot] = sim->sysclock; 
+   sim->ionext[slot] = -1; 
+   sim->ioprev[slot] = sim->iotail; 
+   if (sim->iotail<0) sim->iohead = slot; else sim->ionext[sim->iotail] = slot; 
+   sim->iotail = slot; 
+   sim->nqueued++; 
+   return FALSE; 
+} 
+
+/* whether a waiting request is for a page a process needs now: 
+   the page under its pc, or a pageout that makes room */ 
+static int io_demand(Simulation *sim, long slot) { 
+   Process *q = sim->processes[slot/sim->maxpages]; 
+   return sim->slotpages[slot]<=0 || PAGEOF(sim, q->pc)==slot%sim->maxpages; 
+} 
+
+/* the waiting request to start next. fifo takes the oldest; 
+   demand the oldest demand request, then the oldest prefetch; 
+   deadline orders them all by a deadline, which is when they 
+   were made for demand and iodeadline ticks after for prefetch. 
+   Demand is judged now, as pcs move while requests wait. */ 
+static long io_pick(Simulation *sim) { 
+   long slot, key, best=-1, bestkey=0; 
+   if (sim->iosched==IOSCHED_FIFO) return sim->iohead; 
+   for (slot=sim->iohead; slot>=0; slot=sim->ionext[slot]) { 
+       key = sim->iosubmit[slot]; 
+       if (!io_demand(sim, slot)) 
+	   key += sim->iosched==IOSCHED_DEMAND ? sim->sysclock+1 : sim->iodeadline; 
+       if (best<0 || key<bestkey) { best=slot; bestkey=key; } 
+   } 
+   return best; 
+} 
+
+/* cancel the newest waiting prefetch, to give its frame and its 
+   place in the queue to a demand fault; returns whether there 
+   was one */ 
+static int io_cancel(Simulation *sim) { 
+   long slot, i, j; 
+   Process *q; 
+   for (slot=sim->iotail; slot>=0; slot=sim->ioprev[slot]) 
+       if (sim->slotpages[slot]>0 && !io_demand(sim, slot)) break; 
+   if (slot<0) return FALSE; 
+   i = slot/sim->maxpages; 
+   j = slot%sim->maxpages; 
+   q = sim->processes[i]; 
+   io_unqueue(sim, slot); 
+   sim->ninflight--; 
+   frame_free(sim, slot); 
+   sim->slotpages[slot] = -sim->pagewait-1; 
+   sim_log(sim,LOG_PAGE,"process=%2ld page=%3ld cancel pagein\n",i,j); 
+   sim_event(sim, TR_OUT, i, j, q); 
+   sim_notify(sim, PE_CANCEL, i, j, q); 
+   if (sim->stats) stats_cancel(sim->stats, q->pid, j); 
+   return TRUE; 
+} 
+
+/* one tick of the device: earn bandwidth, then start what 
+   waits, in the order of the scheduler, while channels and 
+   bandwidth allow */ 
+static void io_dispatch(Simulation *sim) { 
+   long slot; 
+   if (sim->bandwidth) { 
+       sim->credit += sim->bandwidth; 
+       if (sim->credit>IOCAP(sim)) sim->credit = IOCAP(sim); 
+   } 
+   while (sim->nqueued && io_ready(sim)) { 
+       slot = io_pick(sim); 
+       io_unqueue(sim, slot); 
+       io_start(sim, slot); 
+       sim_log(sim,LOG_PAGE,"process=%2d page=%3d start %s\n", 
+	       slot/sim->maxpages, slot%sim->maxpages, 
+	       sim->slotpages[slot]>0 ? "pagein" : "pageout"); 
+   } 
 } 
 
 /* unload a process and release all resources */ 
-static void process_unload(int pnum, Process *q) { 
+static void process_unload(Simulation *sim, int pnum, Process *q) { 
    long i; 
+   long slot = (q->pages - sim->slotpages); 
+   if (q->suspended) sim->nsuspended--; 
+   else sim->pcstates[PCSTATE(sim, q->pages[PAGEOF(sim, q->pc)])]--; 
    for (i=0; i<q->npages; i++) 
-       if (q->pages[i]>=-PAGEWAIT) { 
-	   pagesavail++; q->pages[i]=-PAGEWAIT-1; q->blocked[i]=1;
+       if (q->pages[i]>=-sim->pagewait) { 
+	   if (q->pages[i]!=0) { 
+	       sim->ninflight--; 
+	       if (BITTEST(sim->inflight, slot+i)) sim->inservice--; 
+	       else io_unqueue(sim, slot+i); 
+	   } 
+	   frame_free(sim, slot+i); q->pages[i]=-sim->pagewait-1; q->blocked[i]=1;
+	   BITCLEAR(sim->inflight, slot+i); 
        } 
+   if (q->stream) pcstream_close(q->stream); 
+   if (sim->stats) stats_unload(sim->stats, q->pid, q->compute, q->block); 
+   future_free(q); 
    q->active=FALSE; 
-   sim_log(LOG_LOAD,"process %2d; pc %04d: unloaded\n",pnum, q->pc); 
+   sim_log(sim,LOG_LOAD,"process %2d; pc %04d: unloaded\n",pnum, q->pc); 
 } 
 
 /* do a branch if necessary */
-static void process_dobranch(int pnum, Process *q, Branch *b, Bcontext *c) {
+static void process_dobranch(Simulation *sim, int pnum, Process *q, const Branch *b, Bcontext *c) {
    if (bcontext_decide(c)) { 
 	// must document where we branched from
-       if (output) fprintf(output, "%ld,%d,%ld,%ld,%ld,branch_from\n", 
-		sysclock, pnum, q->pid, q->kind, q->pc); 
+       sim_event(sim, TR_BRANCH_FROM, pnum, -1, q); 
        q->pc = b->whereto; 
 	// and where we branched to
-       if (output) fprintf(output, "%ld,%d,%ld,%ld,%ld,branch_to\n", 
-		sysclock, pnum, q->pid, q->kind, q->pc); 
-       sim_log(LOG_BRANCH,"process %2d; pc %04d: branch\n",pnum, q->pc); 
+       sim_event(sim, TR_BRANCH_TO, pnum, -1, q); 
+       sim_log(sim,LOG_BRANCH,"process %2d; pc %04d: branch\n",pnum, q->pc); 
    } else { 
        q->pc++; 
-       sim_log(LOG_BRANCH,"process %2d; pc %04d: no branch\n",pnum, q->pc); 
+       sim_log(sim,LOG_BRANCH,"process %2d; pc %04d: no branch\n",pnum, q->pc); 
    } 
    if (q->pc<0 || q->pc>=q->program->size) q->pc=0; /* start over */ 
 } 
 
+/* step a recorded process to its next pc; a pc out of 
+   sequence is reported as a branch */ 
+static long process_streamstep(Simulation *sim, int pnum, Process *q) { 
+   long next; 
+   if (!pcstream_next(q->stream, &next)) { 
+	sim_event(sim, TR_EXIT, pnum, -1, q); 
+	return FALSE; 
+   } 
+   if (next==q->pc+1) { 
+	q->pc = next; 
+	return TRUE; 
+   } 
+   sim_event(sim, TR_BRANCH_FROM, pnum, -1, q); 
+   q->pc = next; 
+   sim_event(sim, TR_BRANCH_TO, pnum, -1, q); 
+   sim_log(sim,LOG_BRANCH,"process %2d; pc %04d: branch\n",pnum, q->pc); 
+   return TRUE; 
+} 
+
 /* compute one step of a process */ 
-static long process_step(int pnum, Process *q) { 
+static long process_step(Simulation *sim, int pnum, Process *q) { 
    long pc; 
    long page; 
-   long max, min; 
-   Branch *b; 
-   Bcontext *c; 
+   int event; 
 
    if (!q) return FALSE;  
    pc = q->pc; 
-   page = q->pc / PAGESIZE; 
+   page = PAGEOF(sim, q->pc); 
    if (!q->active) { return FALSE; } 
+   if (q->suspended) { q->block++; return TRUE; } 
 
    /* if page swapped out, don't allow to run */ 
    if (q->pages[page]!=0) { 
 	if (!q->blocked[page]) { 
-	    sim_log(LOG_BLOCK,"process=%2d page=%3d blocked\n",pnum,page);
-	    if (output) fprintf(output, "%ld,%d,%ld,%ld,%ld,blocked\n", 
-		sysclock, pnum, q->pid, q->kind, q->pc); 
+	    sim_log(sim,LOG_BLOCK,"process=%2d page=%3d blocked\n",pnum,page);
+	    sim_event(sim, TR_BLOCKED, pnum, -1, q); 
+	    if (sim->stats) stats_fault(sim->stats, q->pid, page, sim->sysclock); 
+	    sim_notify(sim, PE_FAULT, pnum, page, q); 
 	    q->blocked[page]=TRUE; 
 	}
 	q->block++; return TRUE; 
    } else { 
 	if (q->blocked[page]) { 
-	    sim_log(LOG_BLOCK,"process=%2d page=%3d unblocked\n",pnum,page);
-	    if (output) fprintf(output, "%ld,%d,%ld,%ld,%ld,unblocked\n",
-		sysclock,pnum, q->pid, q->kind, q->pc);
+	    sim_log(sim,LOG_BLOCK,"process=%2d page=%3d unblocked\n",pnum,page);
+	    sim_event(sim, TR_UNBLOCKED, pnum, -1, q); 
+	    if (sim->stats) { 
+		stats_unblock(sim->stats, q->pid, sim->sysclock); 
+		stats_use(sim->stats, q->pid, page); 
+	    } 
 	    q->blocked[page]=FALSE; 
         } 
 	q->compute++; 
    }
+   if (q->stream) return process_streamstep(sim,pnum,q); 
 
-   /* should I exit */ 
-   ASSERT(q->program->nexits>=0 && q->program->nexits<=MAXEXITS); 
-   min=0; max=q->program->nexits-1; 
-   while (min+1<max) { 
-       long mid=(min+max)/2; 
-       if (pc==q->program->exits[mid]) { 
-	    if (output) fprintf(output, "%ld,%d,%ld,%ld,%ld,exit\n", 
-		sysclock, pnum, q->pid, q->kind, q->pc);
-	    return FALSE; 
-       } 
-       else if (pc<q->program->exits[mid])  max=mid; 
-       else                                 min=mid; 
-   } 
-   if (pc==q->program->exits[min] || pc==q->program->exits[max]) { 
-	if (output) fprintf(output, "%ld,%d,%ld,%ld,%ld,exit\n", 
-	    sysclock, pnum, q->pid, q->kind, q->pc);
+   /* should I exit or branch */ 
+   ASSERT(pc>=0 && pc<=q->program->size); 
+   event = q->dispatch->pcs[pc].event; 
+   if (event==PC_EXIT) { 
+	sim_event(sim, TR_EXIT, pnum, -1, q); 
 	return FALSE; 
    } 
-   b = q->program->branches; 
-   c = q->bcontexts; 
-   ASSERT(q->program->nbranches>=0 && q->program->nbranches<=MAXBRANCHES); 
-   min=0; max=q->program->nbranches-1; 
-   while (min+1<max) { 
-       long mid=(min+max)/2; 
-       if (pc==b[mid].wherefrom) {
-	    process_dobranch(pnum,q,b+mid,c+mid);
-	    return TRUE;
-       }
-       else if (pc<b[mid].wherefrom) max=mid; 
-       else                          min=mid; 
+   if (event!=PC_LINE) { 
+	process_dobranch(sim,pnum,q,q->program->branches+event,q->bcontexts+event); 
+	return TRUE; 
    } 
-   if (pc==b[min].wherefrom) { process_dobranch(pnum,q,b+min,c+min); return TRUE; } 
-   if (pc==b[max].wherefrom) { process_dobranch(pnum,q,b+max,c+max); return TRUE; } 
    q->pc++; /* default action */ 
    if (q->pc<0 || q->pc>q->program->size) { 
-	if (output) fprintf(output, "%ld,%d,%ld,%ld,%ld,out_of_range\n", 
-	    sysclock, pnum, q->pid, q->kind, q->pc);
+	sim_event(sim, TR_OUT_OF_RANGE, pnum, -1, q); 
 	q->pc=0; /* start over */ 
-	if (output) fprintf(output, "%ld,%d,%ld,%ld,%ld,restart\n", 
-	    sysclock, pnum, q->pid, q->kind, q->pc);
+	sim_event(sim, TR_RESTART, pnum, -1, q); 
    } 
    return TRUE; 
 } 
    
 
 /* public routine: swap one page out */ 
-int pageout(int process, int page) { 
-    if (process<0 || process>=procs 
-     || !processes[process]
-     || !processes[process]->active
-     || page<0 || page>=processes[process]->npages) 
+int pageout(Simulation *sim, int process, int page) { 
+    sim->pageouts++; 
+    if (process<0 || process>=sim->procs 
+     || !sim->processes[process]
+     || !sim->processes[process]->active
+     || page<0 || page>=sim->processes[process]->npages) 
 	return FALSE; 
-    if (processes[process]->pages[page]<0) 
+    if (sim->processes[process]->pages[page]<0) 
 	return TRUE; /* on its way out */ 
-    if (processes[process]->pages[page]>0) 
+    if (sim->processes[process]->pages[page]>0) 
 	return FALSE; /* not available to swap out */ 
-sim_log(LOG_PAGE,"process=%2d page=%3d start pageout\n",process,page);
-    if (pages) fprintf(pages,"%ld,%d,%d,%ld,%ld,going\n",
-	sysclock,process,page,processes[process]->pid, processes[process]->kind); 
-    processes[process]->pages[page]=-1; return TRUE;
+    if (io_submit(sim, process*sim->maxpages+page)) 
+	sim_log(sim,LOG_PAGE,"process=%2d page=%3d start pageout\n",process,page);
+    else 
+	sim_log(sim,LOG_PAGE,"process=%2d page=%3d queue pageout\n",process,page);
+    sim_event(sim, TR_GOING, process, page, sim->processes[process]); 
+    if (sim->stats) stats_pageout(sim->stats, sim->processes[process]->pid, page); 
+    if (page==PAGEOF(sim, sim->processes[process]->pc) && !sim->processes[process]->suspended) { 
+	sim->pcstates[PC_RUNNABLE]--; sim->pcstates[PC_FREEWAIT]++; 
+    } 
+    sim->processes[process]->pages[page]=-1; sim->pagerbusy=TRUE; sim->ninflight++; 
+    return TRUE;
 } 
 
 /* public routine: swap one page in */ 
-int pagein(int process, int page) { 
-    if (process<0 || process>=procs 
-     || !processes[process]
-     || !processes[process]->active
-     || page<0 || page>=processes[process]->npages)
+int pagein(Simulation *sim, int process, int page) { 
+    sim->pageins++; 
+    if (process<0 || process>=sim->procs 
+     || !sim->processes[process]
+     || !sim->processes[process]->active
+     || page<0 || page>=sim->processes[process]->npages)
 	return FALSE; 
-    if (processes[process]->pages[page]>=0) 
+    if (sim->processes[process]->pages[page]>=0) 
 	return TRUE; /* on its way */ 
-    if (pagesavail==0) 
+    if (sim->processes[process]->pages[page]>=-sim->pagewait /* not yet out */ 
+     || ((sim->pagesavail==0 || io_full(sim)) /* no frame, or device busy */ 
+	 && !(sim->iosched!=IOSCHED_FIFO 
+	      && page==PAGEOF(sim, sim->processes[process]->pc) && io_cancel(sim)))) { 
+	if (sim->stats) stats_reject(sim->stats, sim->processes[process]->pid); 
 	return FALSE; 
-    if (processes[process]->pages[page]>=-PAGEWAIT ) 
-	return FALSE; /* not yet out */ 
-    sim_log(LOG_PAGE,"process=%2d page=%3d start pagein\n",process,page);
-    if (pages) fprintf(pages,"%ld,%d,%d,%ld,%ld,coming\n",
-	sysclock,process,page,processes[process]->pid, processes[process]->kind); 
-    processes[process]->pages[page]=PAGEWAIT; pagesavail--; return TRUE; 
+    } 
+    if (io_submit(sim, process*sim->maxpages+page)) 
+	sim_log(sim,LOG_PAGE,"process=%2d page=%3d start pagein\n",process,page);
+    else 
+	sim_log(sim,LOG_PAGE,"process=%2d page=%3d queue pagein\n",process,page);
+    sim_event(sim, TR_COMING, process, page, sim->processes[process]); 
+    if (sim->stats) stats_pagein(sim->stats, sim->processes[process]->pid, page, 
+				 page!=PAGEOF(sim, sim->processes[process]->pc)); 
+    if (page==PAGEOF(sim, sim->processes[process]->pc) && !sim->processes[process]->suspended) { 
+	sim->pcstates[PC_SWAPPED]--; sim->pcstates[PC_MEMWAIT]++; 
+    } 
+    sim->processes[process]->pages[page]=sim->readwait; sim->pagerbusy=TRUE; 
+    frame_take(sim, process*sim->maxpages+page); sim->ninflight++; 
+    return TRUE; 
 } 
 
 /*============
    job queue
   ============*/ 
 
-#define QUEUESIZE (PROGRAMS*8)
-static long queuetype[QUEUESIZE]; 
-static Process queue[QUEUESIZE];
-static long queueend; 
-static void initqueue() { 
+static void initqueue(Simulation *sim) { 
    long i,repeats; 
-   for (i=0; i<QUEUESIZE; i++) queuetype[i]=i%PROGRAMS; 
-   // for (i=0; i<QUEUESIZE; i++) queuetype[i]=lrand48()%PROGRAMS; 
+   long *queuetype; 
+   if (sim->workload) { /* in the order recorded */ 
+       for (i=0; i<sim->queuesize; i++) { 
+	   process_clear(sim->queue+i); 
+	   process_loadstream(sim, sim->queue+i, i); 
+       } 
+       sim->queueend=0; 
+       return; 
+   } 
+   queuetype = calloc(sim->queuesize, sizeof(long)); 
+   if (!queuetype) DIE("out of memory"); 
+   for (i=0; i<sim->queuesize; i++) queuetype[i]=i%sim->nprograms; 
+   // for (i=0; i<sim->queuesize; i++) queuetype[i]=nrand48(sim->rand)%sim->nprograms; 
    for (repeats=0; repeats<10; repeats++) 
-       for (i=0; i<QUEUESIZE; i++) { 
-	  int j=lrand48()%QUEUESIZE;
+       for (i=0; i<sim->queuesize; i++) { 
+	  int j=nrand48(sim->rand)%sim->queuesize;
 	  long temp=queuetype[i]; queuetype[i]=queuetype[j]; queuetype[j]=temp; 
        } 
-   for (i=0; i<QUEUESIZE; i++) { 
-        process_clear(queue+i); 
-	process_load(queue+i,programs+queuetype[i], i, queuetype[i]); 
+   for (i=0; i<sim->queuesize; i++) { 
+        process_clear(sim->queue+i); 
+	process_load(sim,sim->queue+i,sim->programs+queuetype[i], i, queuetype[i]); 
    } 
-   queueend=0; 
+   free(queuetype); 
+   sim->queueend=0; 
 } 
-static Process * dequeue() { 
-   if (queueend<QUEUESIZE) return queue+queueend++; 
-   else return NULL; 
+/* take the next job onto processor pnum */ 
+static Process * dequeue(Simulation *sim, long pnum) { 
+   Process *q; 
+   if (sim->queueend>=sim->queuesize) return NULL; 
+   q = sim->queue+sim->queueend++; 
+   process_place(sim, pnum, q); 
+   sim->pcstates[PC_SWAPPED]++; 
+   if (sim->stats) stats_load(sim->stats, q->pid, q->kind); 
+   return q; 
 } 
-static long empty() { return queueend>=QUEUESIZE; } 
+static long empty(Simulation *sim) { return sim->queueend>=sim->queuesize; } 
 
 /*===========================
    control of all processes 
   ===========================*/ 
 
-static void allprint() { 
+#define PRINTCOLUMNS 10 	/* processes per group printed by allprint() */ 
+
+/* one group of processors, first to first+PRINTCOLUMNS-1 */ 
+static void allprint_group(Simulation *sim, int first) { 
     int i,j; 
-    fprintf(stderr,"\nprocess  "); 
-    for (i=0; i<MAXPROCESSES/2; i++) { 
-	if (i) fprintf(stderr," | "); 
-	if (processes[i] && processes[i]->active) { 
-	    fprintf(stderr,"  %02d",i); 
-        } else { 
-	    fprintf(stderr,"  --"); 
-        }
-    } 
-    fprintf(stderr,"\n"); 
-    fprintf(stderr,"pc       "); 
-    for (i=0; i<MAXPROCESSES/2; i++) { 
-	if (i) fprintf(stderr," | "); 
-	if (processes[i] && processes[i]->active) { 
-	    fprintf(stderr,"%04ld",processes[i]->pc); 
-        } else { 
-	    fprintf(stderr,"----"); 
-        }
-    } 
-    fprintf(stderr,"\n"); 
-    for (j=0; j<MAXPROCPAGES; j++) { 
-	fprintf(stderr,"page%02d  ",j); 
-	for (i=0; i<MAXPROCESSES/2; i++) { 
-	    if (i) fprintf(stderr," |"); 
-	    if (processes[i] && processes[i]->active) { 
-		int pcblock =  processes[i]->pc/PAGESIZE; 
-		if (j==pcblock) { 
-		    if (processes[i]->pages[j]>0) 
-			fprintf(stderr,"*i%3ld",processes[i]->pages[j]); 
-		    else if (processes[i]->pages[j]==0) 
-			fprintf(stderr,"*=in "); 
-		    else if (processes[i]->pages[j]==-100) 
-			fprintf(stderr,"*=out"); 
-		    else 
-			fprintf(stderr,"*o%3ld",100+processes[i]->pages[j]); 
-		    // fprintf(stderr,"*%4d",processes[i]->pages[j]); 
-	  	} else { 
-		    if (processes[i]->pages[j]>0) 
-			fprintf(stderr," i%3ld",processes[i]->pages[j]); 
-		    else if (processes[i]->pages[j]==0) 
-			fprintf(stderr," =in "); 
-		    else if (processes[i]->pages[j]==-100) 
-			fprintf(stderr," =out"); 
-		    else 
-			fprintf(stderr," o%3ld",100+processes[i]->pages[j]); 
-		    // fprintf(stderr," %4d",processes[i]->pages[j]); 
-		} 
-	    } else { 
-		fprintf(stderr," ----"); 
-	    }
-	} 
-	fprintf(stderr,"\n"); 
-    } 
-    fprintf(stderr,"----------------------------------------------------------------------------\n"); 
+    Process *q; 
     fprintf(stderr,"process  "); 
-    for (i=MAXPROCESSES/2; i<MAXPROCESSES; i++) {
-	if (i-MAXPROCESSES/2) fprintf(stderr," | "); 
-	if (processes[i] && processes[i]->active) { 
+    for (i=first; i<first+PRINTCOLUMNS; i++) {
+	if (i-first) fprintf(stderr," | "); 
+	q = i<sim->procs ? sim->processes[i] : NULL; 
+	if (q && q->active) { 
 	    fprintf(stderr,"  %02d",i); 
         } else { 
 	    fprintf(stderr,"  --"); 
@@ -533,41 +981,41 @@ static void allprint() {
     } 
     fprintf(stderr,"\n"); 
     fprintf(stderr,"pc       "); 
-    for (i=MAXPROCESSES/2; i<MAXPROCESSES; i++) {
-	if (i-MAXPROCESSES/2) fprintf(stderr," | "); 
-	if (processes[i] && processes[i]->active) { 
-	    fprintf(stderr,"%04ld",processes[i]->pc); 
+    for (i=first; i<first+PRINTCOLUMNS; i++) {
+	if (i-first) fprintf(stderr," | "); 
+	q = i<sim->procs ? sim->processes[i] : NULL; 
+	if (q && q->active) { 
+	    fprintf(stderr,"%04ld",q->pc); 
         } else { 
 	    fprintf(stderr,"----"); 
         }
     } 
     fprintf(stderr,"\n"); 
-    for (j=0; j<MAXPROCPAGES; j++) { 
+    for (j=0; j<sim->maxpages; j++) { 
 	fprintf(stderr,"page%02d  ",j); 
-	for (i=MAXPROCESSES/2; i<MAXPROCESSES; i++) {
-	    if (i-MAXPROCESSES/2) fprintf(stderr," |"); 
-	    if (processes[i] && processes[i]->active) { 
-		int pcblock =  processes[i]->pc/PAGESIZE; 
+	for (i=first; i<first+PRINTCOLUMNS; i++) {
+	    if (i-first) fprintf(stderr," |"); 
+	    q = i<sim->procs ? sim->processes[i] : NULL; 
+	    if (q && q->active) { 
+		int pcblock =  PAGEOF(sim, q->pc); 
 		if (j==pcblock) { 
-		    if (processes[i]->pages[j]>0) 
-			fprintf(stderr,"*i%3ld",processes[i]->pages[j]); 
-		    else if (processes[i]->pages[j]==0) 
+		    if (q->pages[j]>0) 
+			fprintf(stderr,"*i%3ld",q->pages[j]); 
+		    else if (q->pages[j]==0) 
 			fprintf(stderr,"*=in "); 
-		    else if (processes[i]->pages[j]==-100) 
+		    else if (q->pages[j]==-sim->pagewait) 
 			fprintf(stderr,"*=out"); 
 		    else 
-			fprintf(stderr,"*o%3ld",100+processes[i]->pages[j]); 
-		    // fprintf(stderr,"*%4d",processes[i]->pages[j]); 
+			fprintf(stderr,"*o%3ld",sim->pagewait+q->pages[j]); 
 	  	} else {
-		    if (processes[i]->pages[j]>0) 
-			fprintf(stderr," i%3ld",processes[i]->pages[j]); 
-		    else if (processes[i]->pages[j]==0) 
+		    if (q->pages[j]>0) 
+			fprintf(stderr," i%3ld",q->pages[j]); 
+		    else if (q->pages[j]==0) 
 			fprintf(stderr," =in "); 
-		    else if (processes[i]->pages[j]==-100) 
+		    else if (q->pages[j]==-sim->pagewait) 
 			fprintf(stderr," =out"); 
 		    else 
-			fprintf(stderr," o%3ld",100+processes[i]->pages[j]); 
-		    // fprintf(stderr," %4d",processes[i]->pages[j]); 
+			fprintf(stderr," o%3ld",sim->pagewait+q->pages[j]); 
 		} 
 	    } else { 
 		fprintf(stderr," ----"); 
@@ -578,153 +1026,249 @@ static void allprint() {
     fprintf(stderr,"----------------------------------------------------------------------------\n"); 
 } 
 
-static void endit() { allprint(); exit(0); } 
+static void allprint(Simulation *sim) { 
+    int i, n = sim->procs>MAXPROCESSES ? sim->procs : MAXPROCESSES; 
+    fprintf(stderr,"\n"); 
+    for (i=0; i<n; i+=PRINTCOLUMNS) allprint_group(sim, i); 
+} 
+
+/* public routine: print the state of every process */ 
+void sim_print(Simulation *sim) { allprint(sim); } 
   
-static void allinit () { 
+static void allinit(Simulation *sim) { 
     long i; 
-    initqueue(); 
-    for (i=0; i<MAXPROCESSES; i++) processes[i]=NULL; 
-    for (i=0; i<procs; i++) { 
+    initqueue(sim); 
+    for (i=0; i<sim->procs; i++) sim->processes[i]=NULL; 
+    for (i=0; i<sim->procs; i++) { 
 	// zero out pages from processes
-	if (!empty()) {
-	    processes[i]=dequeue(); 
-
-	    sim_log(LOG_LOAD,"process %2d; pc %04d: loaded\n",i, processes[i]->pc); 
-	    if (output) fprintf(output, "%ld,%ld,%ld,%ld,%ld,load\n", 
-		sysclock, i, processes[i]->pid, 
-		processes[i]->kind, processes[i]->pc);
-	    if (pages) { 
+	if (!empty(sim)) {
+	    sim->processes[i]=dequeue(sim,i); 
+
+	    sim_log(sim,LOG_LOAD,"process %2d; pc %04d: loaded\n",i, sim->processes[i]->pc); 
+	    sim_event(sim, TR_LOAD, i, -1, sim->processes[i]); 
+	    sim_notify(sim, PE_LOAD, i, PAGEOF(sim, sim->processes[i]->pc), sim->processes[i]); 
+	    if (sim->pages || sim->trace) { 
 		long j;
-		for (j=0; j<MAXPROCPAGES; j++) 
-		    fprintf(pages,"%ld,%ld,%ld,%ld,%ld,out\n",
-			sysclock,i,j,processes[i]->pid,processes[i]->kind); 
+		for (j=0; j<sim->maxpages; j++) 
+		    sim_event(sim, TR_OUT, i, j, sim->processes[i]); 
 	    } 
 	} 
     } 
 } 
 
-static void allscore() { 
-    int i; 
-    int block=0; 
-    int compute=0; 
-    for (i=0; i<QUEUESIZE; i++) { 
-	block+=queue[i].block; 
-	compute+=queue[i].compute; 
-    } 
-    sim_log(LOG_ALWAYS, "simulation ends\n"); 
-    sim_log(LOG_ALWAYS, "%d blocked cycles\n",block); 
-    sim_log(LOG_ALWAYS, "%d compute cycles\n",compute); 
-    sim_log(LOG_ALWAYS, "ratio blocked/compute=%g\n",(double)block/(double)compute); 
+static void allscore(Simulation *sim) { 
+    long block=sim_blocked(sim); 
+    long compute=sim_compute(sim); 
+    sim_log(sim,LOG_ALWAYS, "simulation ends\n"); 
+    sim_log(sim,LOG_ALWAYS, "%ld blocked cycles\n",block); 
+    sim_log(sim,LOG_ALWAYS, "%ld compute cycles\n",compute); 
+    sim_log(sim,LOG_ALWAYS, "ratio blocked/compute=%g\n",(double)block/(double)compute); 
 
 } 
 
-static void allstep () { 
-    long i; 
-    for (i=0; i<procs; i++) { 
-	if (!process_step(i,processes[i])) { 
-	    if (processes[i] && processes[i]->active) { 
+static void allstep(Simulation *sim) { 
+    long i, page; 
+    for (i=0; i<sim->procs; i++) { 
+	Process *q = sim->processes[i]; 
+	page = q ? PAGEOF(sim, q->pc) : -1; 
+	if (process_step(sim,i,q)) { 
+	    if (PAGEOF(sim, q->pc)!=page) { 
+		sim->pcstates[PCSTATE(sim, q->pages[page])]--; 
+		sim->pcstates[PCSTATE(sim, q->pages[PAGEOF(sim, q->pc)])]++; 
+		sim_notify(sim, PE_CROSS, i, PAGEOF(sim, q->pc), q); 
+		if (sim->stats && q->pages[PAGEOF(sim, q->pc)]==0) 
+		    stats_use(sim->stats, q->pid, PAGEOF(sim, q->pc)); 
+	    } 
+	} else { 
+	    if (sim->processes[i] && sim->processes[i]->active) { 
 		// document final PC position 
-		if (output) fprintf(output, "%ld,%ld,%ld,%ld,%ld,unload\n", 
-		    sysclock, i, processes[i]->pid, 
-		    processes[i]->kind, processes[i]->pc);
-		if (pages) { 
+		sim_event(sim, TR_UNLOAD, i, -1, sim->processes[i]); 
+		sim_notify(sim, PE_UNLOAD, i, -1, sim->processes[i]); 
+		if (sim->pages || sim->trace) { 
 		    long j;
-		    for (j=0; j<MAXPROCPAGES; j++) 
-			fprintf(pages,"%ld,%ld,%ld,%ld,%ld,out\n",
-			    sysclock,i,j,processes[i]->pid, processes[i]->kind); 
+		    for (j=0; j<sim->maxpages; j++) 
+			sim_event(sim, TR_OUT, i, j, sim->processes[i]); 
 		} 
-		process_unload(i,processes[i]); 
+		process_unload(sim,i,sim->processes[i]); 
 	    } 
-	    processes[i]=NULL; 
-            if (!empty()) {
-		processes[i]=dequeue();
-	        sim_log(LOG_LOAD,"process %2d; pc %04d: loaded\n",i, processes[i]->pc); 
-		if (output) fprintf(output, "%ld,%ld,%ld,%ld,%ld,load\n", 
-		    sysclock, i, processes[i]->pid, 
-		    processes[i]->kind, processes[i]->pc);
+	    sim->processes[i]=NULL; 
+            if (!empty(sim)) {
+		sim->processes[i]=dequeue(sim,i);
+	        sim_log(sim,LOG_LOAD,"process %2d; pc %04d: loaded\n",i, sim->processes[i]->pc); 
+		sim_event(sim, TR_LOAD, i, -1, sim->processes[i]); 
+		sim_notify(sim, PE_LOAD, i, PAGEOF(sim, sim->processes[i]->pc), sim->processes[i]); 
 	    } 
 	} 
     } 
 } 
 
-static long alldone () { 
+static long alldone(Simulation *sim) { 
     long i; 
-    for (i=0; i<procs; i++) { 
-	if (processes[i] && processes[i]->active) return FALSE; 
+    for (i=0; i<sim->procs; i++) { 
+	if (sim->processes[i] && sim->processes[i]->active) return FALSE; 
     } 
     return TRUE; 
 } 
 
-static int allblocked() { 
-    int allfree=0; 
-    int runnable=0; 
-    int memwait=0; 
-    int freewait=0; 
-    int i,stat; 
-    for (i=0; i<procs; i++) 
-	if (processes[i] && processes[i]->active) { 
-	    stat=processes[i]->pages[(int)(processes[i]->pc/PAGESIZE)]; 
-	    if (stat>0) memwait++;	/* waiting for swap in */ 
-	    else if (stat==0) runnable++; /* ok */ 
-	    else if (stat<-PAGEWAIT) allfree++; /* free */
-	    else freewait++; /* waiting for swap out */ 
-	} 
-
-    if (allfree && !memwait && !runnable && !freewait) { 
-	sim_log(LOG_DEAD,"%d process pcs waiting for swap in\n",memwait); 
-	sim_log(LOG_DEAD,"%d process pcs runnable\n",runnable); 
-	sim_log(LOG_DEAD,"%d process pcs waiting for swap out\n",freewait); 
-	sim_log(LOG_DEAD,"%d process pcs swapped out\n",allfree); 
-	sim_log(LOG_DEAD, "All needed pages swapped out!\n"); 
-	// allprint(); 
-	return 1; 
-    } else { 
+/* whether every running process waits on a page that is swapped 
+   out, from the counts kept as pages and pcs move; with -giveup, 
+   the run ends once that has lasted giveup ticks with no page in 
+   flight at all */ 
+static int allblocked(Simulation *sim) { 
+    long *n = sim->pcstates; 
+    long i; 
+    if ((!n[PC_SWAPPED] && !sim->nsuspended) 
+     || n[PC_MEMWAIT] || n[PC_RUNNABLE] || n[PC_FREEWAIT]) { 
+	sim->stuck=0; 
 	return 0; 
     } 
+    sim_log(sim,LOG_DEAD,"%ld process pcs waiting for swap in\n",n[PC_MEMWAIT]); 
+    sim_log(sim,LOG_DEAD,"%ld process pcs runnable\n",n[PC_RUNNABLE]); 
+    sim_log(sim,LOG_DEAD,"%ld process pcs waiting for swap out\n",n[PC_FREEWAIT]); 
+    sim_log(sim,LOG_DEAD,"%ld process pcs swapped out\n",n[PC_SWAPPED]); 
+    sim_log(sim,LOG_DEAD,"%ld processes suspended\n",sim->nsuspended); 
+    sim_log(sim,LOG_DEAD, "All needed pages swapped out!\n"); 
+    // allprint(sim); 
+    if (sim->ninflight) sim->stuck=0; 
+    else if (sim->giveup && ++sim->stuck>=sim->giveup) { 
+	sim_log(sim,LOG_ALWAYS,"no process has run and no page has moved for %ld ticks; " 
+		"giving up\n",sim->stuck); 
+	sim_log(sim,LOG_ALWAYS,"%ld processes wait on swapped out pages, %ld jobs never started\n", 
+		n[PC_SWAPPED],sim->queuesize-sim->queueend); 
+	for (i=0; i<sim->procs; i++) { 
+	    Process *q = sim->processes[i]; 
+	    if (q && q->active && q->suspended) 
+		sim_log(sim,LOG_DEAD,"process %2ld is suspended\n",i); 
+	    else if (q && q->active) 
+		sim_log(sim,LOG_DEAD,"process %2ld waits on page %3ld\n",i,PAGEOF(sim, q->pc)); 
+	} 
+	sim->givenup=TRUE; 
+    } 
+    return 1; 
 } 
 
-static void allage () { 
-   long i; 
-   for (i=0; i<procs; i++) { 
-       if (processes[i] && processes[i]->active) { 
-    	   long j; 	
-	   for (j=0; j<processes[i]->npages; j++) {
-                if (processes[i]->pages[j]==0) ; 
-                else if (processes[i]->pages[j]<-PAGEWAIT) ; 
-		else if (processes[i]->pages[j]>0) { 
-		    processes[i]->pages[j]--; 
-		    if (processes[i]->pages[j]==0) { 
-			sim_log(LOG_PAGE,"process=%2d page=%3d end   pagein\n",i,j);
-			if (pages) fprintf(pages,"%ld,%ld,%ld,%ld,%ld,in\n",
-			    sysclock,i,j,processes[i]->pid, processes[i]->kind); 
-		    } 
-		} else if (processes[i]->pages[j]<0 
-                       && processes[i]->pages[j]>=-PAGEWAIT) {
-		    processes[i]->pages[j]--; 
-		    if(processes[i]->pages[j]<-PAGEWAIT) { 
-			sim_log(LOG_PAGE,"process=%2d page=%3d end   pageout\n",i,j);
-			if (pages) fprintf(pages,"%ld,%ld,%ld,%ld,%ld,out\n",
-			    sysclock,i,j,processes[i]->pid, processes[i]->kind); 
-			pagesavail++; 
-		    } 
-                } 
-	    } 
-	} 
+/* advance every pagein and pageout by one tick. Only pages in 
+   the inflight bitset can change, so whole words of resident or 
+   free pages are skipped; the pages that finish are gathered in 
+   slab order, which is the order of processes and their pages, 
+   and reported afterwards. */ 
+static void allage(Simulation *sim) { 
+   long w, k, slot, ncompleted=0; 
+   long wait = sim->pagewait; 
+   long nwords = BITWORDS(sim->procs*sim->maxpages); 
+   long *pages = sim->slotpages; 
+   unsigned long *inflight = sim->inflight; 
+   for (w=0; w<nwords; w++) { 
+       unsigned long bits = inflight[w]; 
+       while (bits) { 
+	   slot = w*WORDBITS + __builtin_ctzl(bits); 
+	   bits &= bits-1; 
+	   pages[slot]--; 
+	   if (pages[slot]==0 || pages[slot]<-wait) { 
+	       BITCLEAR(inflight, slot); 
+	       sim->completed[ncompleted++] = slot; 
+	   } 
+       } 
+   } 
+   sim->ninflight -= ncompleted; 
+   sim->inservice -= ncompleted; 
+   for (k=0; k<ncompleted; k++) { 
+       long i = sim->completed[k]/sim->maxpages; 
+       long j = sim->completed[k]%sim->maxpages; 
+       Process *q = sim->processes[i]; 
+       long current = j==PAGEOF(sim, q->pc) && !q->suspended; 
+       if (pages[sim->completed[k]]==0) { 
+	   if (current) { sim->pcstates[PC_MEMWAIT]--; sim->pcstates[PC_RUNNABLE]++; } 
+	   sim_log(sim,LOG_PAGE,"process=%2d page=%3d end   pagein\n",i,j);
+	   sim_event(sim, TR_IN, i, j, q); 
+	   sim_notify(sim, PE_IN, i, j, q); 
+       } else { 
+	   sim_log(sim,LOG_PAGE,"process=%2d page=%3d end   pageout\n",i,j);
+	   sim_event(sim, TR_OUT, i, j, q); 
+	   sim_notify(sim, PE_OUT, i, j, q); 
+	   if (current) { sim->pcstates[PC_FREEWAIT]--; sim->pcstates[PC_SWAPPED]++; } 
+	   frame_free(sim, sim->completed[k]); 
+       } 
    } 
+   if (sim->nqueued || sim->bandwidth) io_dispatch(sim); 
+} 
+
+/*================================
+   wall time of a run (-timing) 
+  ================================*/ 
+
+static long timing_now(void) { 
+    struct timespec t; 
+    clock_gettime(CLOCK_MONOTONIC, &t); 
+    return t.tv_sec*1000000000L + t.tv_nsec; 
+} 
+
+/* bucket of a latency: exact below 16 ns, then 16 per power of two */ 
+static long timing_bucket(long ns) { 
+    long shift = 0; 
+    if (ns<16) return ns<0 ? 0 : ns; 
+    while ((ns>>shift)>=32) shift++; 
+    return (shift+1)*16 + ((ns>>shift)&15); 
+} 
+
+/* smallest latency of a bucket */ 
+static long timing_floor(long b) { 
+    if (b<16) return b; 
+    return (16+b%16) << (b/16-1); 
 } 
 
-static void callyou() { 
-    long i,j; 
+static void timing_pager(Timing *t, long start) { 
+    long ns = timing_now()-start; 
+    t->pagerns += ns; 
+    t->latency[timing_bucket(ns)]++; 
+} 
+
+/* latency below which fraction of the pager's calls took */ 
+static long timing_percentile(Timing *t, double fraction) { 
+    long b, calls=0, seen=0; 
+    for (b=0; b<LATENCYBUCKETS; b++) calls += t->latency[b]; 
+    for (b=0; b<LATENCYBUCKETS; b++) { 
+	seen += t->latency[b]; 
+	if (seen>0 && seen>=fraction*calls) return timing_floor(b); 
+    } 
+    return 0; 
+} 
+
+static void timing_report(Simulation *sim) { 
+    Timing *t = sim->timing; 
+    long p, ticks = t->ticks ? t->ticks : 1; 
+    sim_log(sim,LOG_ALWAYS,"timing: %ld ticks simulated of %ld\n", t->ticks, sim->sysclock); 
+    for (p=0; p<PHASES; p++) 
+	sim_log(sim,LOG_ALWAYS,"timing: %-10s %9.1f ns/tick\n", phase_names[p], 
+		(double)t->ns[p]/ticks); 
+    sim_log(sim,LOG_ALWAYS,"timing: %-10s %9.1f ns/tick, p50 %ld ns, p99 %ld ns\n", 
+	    sim->pager->name, (double)t->pagerns/ticks, 
+	    timing_percentile(t, 0.50), timing_percentile(t, 0.99)); 
+    sim_log(sim,LOG_ALWAYS,"timing: %.3f pagein and %.3f pageout calls/tick\n", 
+	    (double)sim->pageins/ticks, (double)sim->pageouts/ticks); 
+} 
+
+static void callyou(Simulation *sim) { 
+    long i,j,start=0; 
     Pentry pentry[MAXPROCESSES];
+    sim->pagerbusy=FALSE; 
+    if (sim->pager->pageupdate) { 
+	if (sim->timing) start = timing_now(); 
+	sim->pager->pageupdate(sim, sim->events, sim->nevents); 
+	sim->nevents=0; 
+	if (sim->timing && !sim->pager->pageit) timing_pager(sim->timing, start); 
+    } 
+    if (!sim->pager->pageit) return; /* no snapshot needed */ 
+    /* sim_check() keeps pageit() to geometries that fit a Pentry */ 
     for (i=0; i<MAXPROCESSES; i++) { 
-	if (processes[i]) { 
-	    pentry[i].active=processes[i]->active; 
-	    pentry[i].pc=processes[i]->pc; 
-	    pentry[i].npages = processes[i]->npages; 
-	    for (j=0; j<processes[i]->npages; j++) {
-		pentry[i].pages[j]=(processes[i]->pages[j]==0); 
-	    } 
-	    for (; j<MAXPROCPAGES; j++) pentry[i].pages[j]=FALSE; 
+	Process *q = i<sim->procs ? sim->processes[i] : NULL; 
+	if (q) { 
+	    long n = q->npages, *pages = q->pages, *in = pentry[i].pages; 
+	    pentry[i].active=q->active; 
+	    pentry[i].pc=q->pc; 
+	    pentry[i].npages = n; 
+	    for (j=0; j<n; j++) in[j]=(pages[j]==0); 
+	    for (; j<MAXPROCPAGES; j++) in[j]=FALSE; 
         } else { 
 	    pentry[i].active=FALSE; 
 	    pentry[i].pc=0; 
@@ -732,110 +1276,428 @@ static void callyou() {
 	    for (j=0; j<MAXPROCPAGES; j++) pentry[i].pages[j]=FALSE; 
         } 
     } 
-    pageit(pentry); 	/* call your routine */ 
+    if (sim->timing && !sim->pager->pageupdate) start = timing_now(); 
+    sim->pager->pageit(sim, pentry); 	/* call your routine */ 
+    if (sim->timing) timing_pager(sim->timing, start); 
 } 
 
-int main(int argc, char **argv) { 
-    
-    long i,errors=0,help=0; 
- 
-    signal(SIGINT, endit); 
-    
-    log_port=LOG_ALWAYS; 
-    for (i=1; i<argc; i++) { 
-	if (strcmp(argv[i],"-help")==0) { 
-	    help++;
-	} else if (strcmp(argv[i],"-all")==0) { 
-	    log_port |= LOG_LOAD|LOG_BLOCK|LOG_PAGE|LOG_BRANCH; 
-	} else if (strcmp(argv[i],"-load")==0) { 
-	    log_port |= LOG_LOAD; 
-	} else if (strcmp(argv[i],"-block")==0) { 
-	    log_port |= LOG_BLOCK; 
-	} else if (strcmp(argv[i],"-page")==0) { 
-	    log_port |= LOG_PAGE; 
-	} else if (strcmp(argv[i],"-branch")==0) { 
-	    log_port |= LOG_BRANCH; 
-	} else if (strcmp(argv[i],"-dead")==0) { 
-	    log_port |= LOG_DEAD; 
-	} else if (strcmp(argv[i],"-seed")==0) { 
-	    if (sscanf(argv[++i],"%ld",&seed)!=1) {
-		fprintf(stderr,
-			"%s: could not read random seed from command line\n",
-			argv[0]); 
-		errors++; 
-	    } else if (seed<1 || seed>((1<<30)-1)) {
-		fprintf(stderr,
-			"%s: random seed must be between 1 and %d\n",
-			argv[0], (1<<30)-1); 
-		errors++; 
-	    } 
-	} else if (strcmp(argv[i],"-csv")==0) { 
-	    output = fopen("output.csv", "w"); 
-            if (!output) { 
-		fprintf(stderr,
-			"%s: could not open output.csv for writing\n",
-			argv[0]); 
-		errors++; 
-	    } 
-	    pages = fopen("pages.csv", "w"); 
-            if (!pages) { 
-		fprintf(stderr,
-			"%s: could not open pages.csv for writing\n",
-			argv[0]); 
-		errors++; 
-	    } 
-	} else if (strcmp(argv[i],"-procs")==0) { 
-	    if (sscanf(argv[++i],"%ld",&procs)!=1) {
-		fprintf(stderr,
-			"%s: could not read number of processors from command line\n",
-			argv[0]); 
-		errors++; 
-	    } else if (procs<1 || procs>MAXPROCESSES) {
-		fprintf(stderr,
-			"%s: number of processors must be between 1 and %d\n",
-			argv[0], MAXPROCESSES); 
-		errors++; 
-	    } 
-        } else { 
-	    fprintf(stderr, "t4: unrecognized argument %s\n", argv[i]); 
-	    errors++; 
- 	} 
-    } 
-    if (errors || help) { 
-	fprintf(stderr, "%s usage: %s \n", argv[0], argv[0]); 
-        fprintf(stderr, "  -all       log everything\n"); 
-	fprintf(stderr, "  -load      log loading of processes\n"); 
-	fprintf(stderr, "  -unload    log unloading of processes\n"); 
-	fprintf(stderr, "  -branch    log program branches\n"); 
-	fprintf(stderr, "  -page      log page in and out\n"); 
-	fprintf(stderr, "  -seed 512  set random seed to 512\n"); 
-	fprintf(stderr, "  -procs 4   run only four processors\n"); 
-	fprintf(stderr, "  -dead      detect deadlocks\n"); 
-	fprintf(stderr, "  -csv       generate output.csv and pages.csv for graphing\n");
-	if(errors) {
-	    return EXIT_FAILURE;
-	}
-	else {
-	    return EXIT_SUCCESS;
-	}
+/* number of ticks process q can run before it reaches a branch, 
+   an exit, or the end of its current page */ 
+static long process_horizon(Simulation *sim, Process *q) { 
+    long horizon; 
+    long pc = q->pc; 
+    horizon = sim->pagesize-1 - pc%sim->pagesize; 
+    if (q->stream) return pcstream_run(q->stream, pc, horizon); 
+    if (q->dispatch->pcs[pc].run < horizon) horizon = q->dispatch->pcs[pc].run; 
+    return horizon; 
+} 
+
+/* event-driven time warp: if the pager did nothing on this tick, 
+   jump sysclock forward to just before the next tick on which 
+   the pager's view can change: a pagein or pageout completion, 
+   a branch or exit, a page boundary, or a block/unblock. 
+   The skipped ticks are accounted exactly as allstep() and 
+   allage() would have, so allscore() totals are unchanged as 
+   long as pageit() depends upon pc only through its page. */ 
+static void allwarp(Simulation *sim) { 
+    long i, w, slot, v, page, horizon=-1; 
+    long nwords = BITWORDS(sim->procs*sim->maxpages); 
+    unsigned long bits; 
+    if (sim->pagerbusy) return; 
+    for (i=0; i<sim->procs; i++) { 
+	Process *q = sim->processes[i]; 
+	if (!q || !q->active || q->suspended) continue; 
+	page = PAGEOF(sim, q->pc); 
+	if (q->pages[page]!=0) { 
+	    if (!q->blocked[page]) return; /* block not reported yet */ 
+	} else { 
+	    if (q->blocked[page]) return;  /* unblock not reported yet */ 
+	    v = process_horizon(sim, q); 
+	    if (horizon<0 || v<horizon) horizon=v; 
+	} 
+	if (horizon==0) return; 
+    } 
+    for (w=0; w<nwords; w++) 
+	for (bits=sim->inflight[w]; bits; bits&=bits-1) { 
+	    v = sim->slotpages[w*WORDBITS + __builtin_ctzl(bits)]; 
+	    if (v>0) v = v-1;        /* ticks before pagein ends */ 
+	    else v = v+sim->pagewait; /* before pageout ends */ 
+	    if (horizon<0 || v<horizon) horizon=v; 
+	    if (horizon==0) return; 
+	} 
+    if (sim->nqueued && sim->bandwidth && sim->credit<IOCOST 
+	&& (!sim->channels || sim->inservice<sim->channels)) { 
+	/* the next transfer waits for bandwidth alone */ 
+	v = (IOCOST-sim->credit+sim->bandwidth-1)/sim->bandwidth - 1; 
+	if (horizon<0 || v<horizon) horizon=v; 
+    } 
+    if (horizon<=0) return; /* nothing running and nothing in flight */ 
+    for (i=0; i<sim->procs; i++) { 
+	Process *q = sim->processes[i]; 
+	if (!q || !q->active) continue; 
+	if (q->suspended || q->pages[PAGEOF(sim, q->pc)]!=0) { 
+	    q->block+=horizon; 
+	} else { 
+	    q->compute+=horizon; q->pc+=horizon; 
+	    if (q->stream) pcstream_skip(q->stream, horizon); 
+	} 
+    } 
+    for (w=0; w<nwords; w++) 
+	for (bits=sim->inflight[w]; bits; bits&=bits-1) { 
+	    slot = w*WORDBITS + __builtin_ctzl(bits); 
+	    sim->slotpages[slot]-=horizon; 
+	} 
+    if (sim->bandwidth) { 
+	sim->credit += horizon*sim->bandwidth; 
+	if (sim->credit>IOCAP(sim)) sim->credit = IOCAP(sim); 
+    } 
+    sim->sysclock+=horizon; 
+} 
+
+/*=====================
+   simulation contexts 
+  =====================*/ 
+
+/* default options: those of a command line without arguments */ 
+void sim_defaults(Simoptions *opt) { 
+    opt->pager = pager_find("lru"); 
+    opt->seed = 0; 
+    opt->procs = MAXPROCESSES; 
+    opt->frames = PHYSICALPAGES; 
+    opt->pagesize = PAGESIZE; 
+    opt->maxpages = MAXPROCPAGES; 
+    opt->pagewait = PAGEWAIT; 
+    opt->readwait = 0; 
+    opt->writewait = 0; 
+    opt->channels = 0; 
+    opt->bandwidth = 0; 
+    opt->ioqueue = 0; 
+    opt->iosched = IOSCHED_FIFO; 
+    opt->iodeadline = 0; 
+    opt->warp = FALSE; 
+    opt->giveup = 0; 
+    opt->log = LOG_ALWAYS; 
+    opt->output = NULL; 
+    opt->pages = NULL; 
+    opt->trace = NULL; 
+    opt->stats = NULL; 
+    opt->statscsv = FALSE; 
+    opt->timing = FALSE; 
+    opt->workload = NULL; 
+    opt->programs = NULL; 
+    opt->nprograms = 0; 
+} 
+
+/* public routine: why options can't run, or NULL if they can */ 
+const char *sim_check(const Simoptions *opt) { 
+    if (opt->procs<1 || opt->procs>SIMLIMIT) 
+	return "number of processors out of range"; 
+    if (opt->maxpages<1 || opt->maxpages>SIMLIMIT) 
+	return "pages per process out of range"; 
+    if (opt->pagesize<1) return "page size out of range"; 
+    if (opt->pagewait<1) return "page wait out of range"; 
+    if (opt->readwait<0 || opt->writewait<0) return "read or write wait out of range"; 
+    if (opt->channels<0 || opt->bandwidth<0 || opt->ioqueue<0) 
+	return "swap device channels, bandwidth or queue out of range"; 
+    if (opt->iosched<IOSCHED_FIFO || opt->iosched>IOSCHED_DEADLINE || opt->iodeadline<0) 
+	return "swap device scheduler out of range"; 
+    if (opt->frames<0) return "number of frames out of range"; 
+    if (opt->workload) { 
+	if (opt->workload->maxpc >= opt->maxpages*opt->pagesize) 
+	    return "workload has a pc beyond the last page"; 
+    } else { 
+	const Program *p = opt->programs ? opt->programs : programs; 
+	long i, n = opt->programs ? opt->nprograms : PROGRAMS; 
+	for (i=0; i<n; i++) if (p[i].size >= opt->maxpages*opt->pagesize) 
+	    return "program has more lines than its pages hold"; 
+    } 
+    if (opt->pager->pageit && (opt->procs>MAXPROCESSES 
+	    || opt->maxpages>MAXPROCPAGES || opt->pagesize!=PAGESIZE)) 
+	return "pageit() pagers need at most MAXPROCESSES processors, " 
+	       "MAXPROCPAGES pages and PAGESIZE; use a pageupdate() pager"; 
+    return NULL; 
+} 
+
+/* create a simulation; nothing runs until sim_run() */ 
+Simulation *sim_create(const Simoptions *opt) { 
+    long i; 
+    Simulation *sim = calloc(1, sizeof(Simulation)); 
+    if (!sim) DIE("out of memory"); 
+    sim->workload = opt->workload; 
+    sim->programs = opt->programs ? opt->programs : programs; 
+    sim->nprograms = opt->programs ? opt->nprograms : PROGRAMS; 
+    /* as many repeats per MAXPROCESSES processors */ 
+    sim->queuesize = sim->workload ? sim->workload->nprocs 
+                                   : sim->nprograms*QUEUEREPEATS 
+                                     *((opt->procs+MAXPROCESSES-1)/MAXPROCESSES); 
+    if (!sim->workload) { 
+	sim->dispatch = calloc(sim->nprograms, sizeof(Dispatch)); 
+	if (!sim->dispatch) DIE("out of memory"); 
+	for (i=0; i<sim->nprograms; i++) 
+	    dispatch_build(sim->dispatch+i, sim->programs+i); 
+    } 
+    sim->queue = calloc(sim->queuesize, sizeof(Process)); 
+    if (!sim->queue) DIE("out of memory"); 
+    if (sim->workload) { 
+	sim->streams = calloc(sim->queuesize, sizeof(Pcstream)); 
+	if (!sim->streams) DIE("out of memory"); 
+    } 
+    sim->pager = opt->pager; 
+    sim->seed = opt->seed; 
+    sim->procs = opt->procs; 
+    sim->pagesize = opt->pagesize; 
+    for (sim->pageshift=0; (1L<<sim->pageshift)<sim->pagesize; sim->pageshift++) ; 
+    if ((1L<<sim->pageshift)!=sim->pagesize) sim->pageshift=-1; 
+    sim->maxpages = opt->maxpages; 
+    sim->pagewait = opt->writewait ? opt->writewait : opt->pagewait; 
+    sim->readwait = opt->readwait ? opt->readwait : opt->pagewait; 
+    sim->channels = opt->channels; 
+    sim->bandwidth = opt->bandwidth; 
+    sim->ioqueue = opt->ioqueue; 
+    sim->iosched = opt->iosched; 
+    sim->iodeadline = opt->iodeadline ? opt->iodeadline : sim->readwait; 
+    sim->credit = IOCAP(sim); 
+    sim->iohead = sim->iotail = -1; 
+    sim->geometry.procs = sim->procs; 
+    sim->geometry.maxpages = sim->maxpages; 
+    sim->geometry.pagesize = sim->pagesize; 
+    sim->geometry.pagewait = opt->pagewait; 
+    sim->geometry.frames = opt->frames; 
+    sim->geometry.readwait = sim->readwait; 
+    sim->geometry.writewait = sim->pagewait; 
+    sim->geometry.channels = sim->channels; 
+    sim->geometry.bandwidth = sim->bandwidth; 
+    sim->geometry.ioqueue = sim->ioqueue; 
+    sim->geometry.iosched = sim->iosched; 
+    sim->processes = calloc(sim->procs, sizeof(Process *)); 
+    sim->slotpages = calloc(sim->procs*sim->maxpages, sizeof(long)); 
+    sim->slotblocked = calloc(sim->procs*sim->maxpages, sizeof(long)); 
+    sim->inflight = calloc(BITWORDS(sim->procs*sim->maxpages), sizeof(unsigned long)); 
+    sim->completed = calloc(sim->procs*sim->maxpages, sizeof(long)); 
+    sim->freeframes = malloc((opt->frames ? opt->frames : 1)*sizeof(long)); 
+    sim->frameslot = malloc((opt->frames ? opt->frames : 1)*sizeof(long)); 
+    sim->slotframe = malloc(sim->procs*sim->maxpages*sizeof(long)); 
+    sim->ionext = malloc(sim->procs*sim->maxpages*sizeof(long)); 
+    sim->ioprev = malloc(sim->procs*sim->maxpages*sizeof(long)); 
+    sim->iosubmit = malloc(sim->procs*sim->maxpages*sizeof(long)); 
+    if (!sim->processes || !sim->slotpages || !sim->slotblocked 
+	|| !sim->inflight || !sim->completed 
+	|| !sim->freeframes || !sim->frameslot || !sim->slotframe 
+	|| !sim->ionext || !sim->ioprev || !sim->iosubmit) 
+	DIE("out of memory"); 
+    /* frame 0 is handed out first */ 
+    for (i=0; i<opt->frames; i++) { 
+	sim->freeframes[i] = opt->frames-1-i; 
+	sim->frameslot[i] = -1; 
     } 
-    if (seed==0) { 
-	seed = (time(NULL)*38491+71831+time(NULL)*time(NULL))&((1<<30)-1); 
+    for (i=0; i<sim->procs*sim->maxpages; i++) sim->slotframe[i] = -1; 
+    sim->pagesavail = opt->frames; 
+    sim->warp = opt->warp; 
+    sim->giveup = opt->giveup; 
+    sim->log_port = opt->log; 
+    sim->output = opt->output; 
+    sim->pages = opt->pages; 
+    sim->trace = opt->trace; 
+    if (opt->timing) { 
+	sim->timing = calloc(1, sizeof(Timing)); 
+	if (!sim->timing) DIE("out of memory"); 
     } 
-    srand48(seed); 
-    sim_log(LOG_ALWAYS,"random seed %d\n", seed); 
-    sim_log(LOG_ALWAYS,"using %d processors\n", procs); 
+    if (opt->stats) { 
+	sim->stats = stats_create(sim->queuesize, sim->maxpages); 
+	if (!sim->stats) DIE("out of memory"); 
+	sim->statsfile = opt->stats; 
+	sim->statscsv = opt->statscsv; 
+    } 
+    /* same stream as srand48(seed) */ 
+    sim->rand[0] = 0x330E; 
+    sim->rand[1] = sim->seed & 0xffff; 
+    sim->rand[2] = (sim->seed>>16) & 0xffff; 
+    return sim; 
+} 
+
+/* sample the resident set size at every STATSINTERVAL ticks passed; 
+   nothing is resident or freed during ticks that allwarp() skips */ 
+static void allsample(Simulation *sim) { 
+    long i, resident=0, inflight=0; 
+    if (sim->sysclock<sim->nextsample) return; 
+    for (i=0; i<sim->procs*sim->maxpages; i++) { 
+	if (sim->slotpages[i]==0) resident++; 
+	else if (sim->slotpages[i]>=-sim->pagewait) inflight++; 
+    } 
+    for (; sim->nextsample<=sim->sysclock; sim->nextsample+=STATSINTERVAL) 
+	stats_sample(sim->stats, sim->nextsample, resident, inflight); 
+} 
+
+/* the loop of sim_run(), timing each phase */ 
+static void sim_runtimed(Simulation *sim) { 
+    Timing *t = sim->timing; 
+    long a, b; 
+    while (!alldone(sim) && !sim->givenup) { 
+	a = timing_now(); 
+	allstep(sim); 
+	b = timing_now(); t->ns[PH_STEP] += b-a; 
+        allage(sim); 
+	a = timing_now(); t->ns[PH_AGE] += a-b; 
+        callyou(sim); 
+	b = timing_now(); t->ns[PH_CALLYOU] += b-a; 
+	sim->sysclock++; 
+	allblocked(sim); 
+	a = timing_now(); t->ns[PH_BLOCKED] += a-b; 
+	if (sim->warp) allwarp(sim); 
+	b = timing_now(); t->ns[PH_WARP] += b-a; 
+	if (sim->stats) allsample(sim); 
+	t->ticks++; 
+    } 
+} 
+
+/* run a simulation to completion */ 
+void sim_run(Simulation *sim) { 
+    sim_log(sim,LOG_ALWAYS,"random seed %d\n", sim->seed); 
+    sim_log(sim,LOG_ALWAYS,"using %d processors\n", sim->procs); 
+    sim_log(sim,LOG_ALWAYS,"using pager %s\n", sim->pager->name); 
     
-    allinit(); 
-    while (!alldone()) { // all processes inactive
-	allstep(); 	 // advance time one tick; if process done, reload
-        allage(); 	 // advance time for page wait variables. 
-        callyou(); 	 // call your program
-	sysclock++;      // remember new time. 
-	allblocked();    // deadlock detection 
+    allinit(sim); 
+    if (sim->timing) { 
+	sim_runtimed(sim); 
+    } else while (!alldone(sim) && !sim->givenup) { // all processes inactive
+	allstep(sim); 	 // advance time one tick; if process done, reload
+        allage(sim); 	 // advance time for page wait variables. 
+        callyou(sim); 	 // call your program
+	sim->sysclock++; // remember new time. 
+	allblocked(sim); // deadlock detection 
+	if (sim->warp) allwarp(sim); // jump to the next interesting tick 
+	if (sim->stats) allsample(sim); 
+    } 
+    allscore(sim); 
+    if (sim->timing) timing_report(sim); 
+    if (sim->stats) stats_write(sim->stats, sim->statsfile, sim->statscsv, 
+				sim->pager->name, sim->seed); 
+} 
+
+/* totals over the whole job queue, as reported by allscore() */ 
+long sim_blocked(Simulation *sim) { 
+    long i, block=0; 
+    for (i=0; i<sim->queuesize; i++) block+=sim->queue[i].block; 
+    return block; 
+} 
+
+long sim_compute(Simulation *sim) { 
+    long i, compute=0; 
+    for (i=0; i<sim->queuesize; i++) compute+=sim->queue[i].compute; 
+    return compute; 
+} 
+
+/* release a simulation and everything its pager allocated */ 
+void sim_destroy(Simulation *sim) { 
+    long i; 
+    if (sim->output) fclose(sim->output); 
+    if (sim->pages) fclose(sim->pages); 
+    if (sim->trace) trace_close(sim->trace); 
+    if (sim->stats) { 
+	stats_free(sim->stats); 
+	fclose(sim->statsfile); 
     } 
-    allscore(); 
+    if (sim->streams) 
+	for (i=0; i<sim->queuesize; i++) pcstream_close(sim->streams+i); 
+    for (i=0; i<sim->queuesize; i++) future_free(sim->queue+i); 
+    free(sim->pagerdata); 
+    free(sim->events); 
+    if (sim->dispatch) 
+	for (i=0; i<sim->nprograms; i++) free(sim->dispatch[i].pcs); 
+    free(sim->dispatch); 
+    free(sim->streams); 
+    free(sim->queue); 
+    free(sim->processes); 
+    free(sim->slotpages); 
+    free(sim->slotblocked); 
+    free(sim->inflight); 
+    free(sim->timing); 
+    free(sim->completed); 
+    free(sim->freeframes); 
+    free(sim->frameslot); 
+    free(sim->slotframe); 
+    free(sim->ionext); 
+    free(sim->ioprev); 
+    free(sim->iosubmit); 
+    free(sim); 
+} 
 
-    return EXIT_SUCCESS;
+/* public routine: the geometry the pager works with */ 
+const Geometry *sim_geometry(Simulation *sim) { return &sim->geometry; } 
 
+/* public routine: IOSCHED_* named by -iosched, or -1 */ 
+long iosched_find(const char *name) { 
+    static const char *names[] = { "fifo", "demand", "deadline" }; 
+    long i; 
+    for (i=IOSCHED_FIFO; i<=IOSCHED_DEADLINE; i++) 
+	if (strcmp(names[i], name)==0) return i; 
+    return -1; 
 } 
+
+/* public routines: the swap device */ 
+long sim_ioqueued(Simulation *sim) { return sim->nqueued; } 
+int sim_iobusy(Simulation *sim) { return io_full(sim); } 
+
+/* public routines: the frame table */ 
+long sim_freeframes(Simulation *sim) { return sim->pagesavail; } 
+
+/* public routines: load control */ 
+int sim_suspend(Simulation *sim, int process) { 
+    Process *q; 
+    if (process<0 || process>=sim->procs || !sim->processes[process] 
+     || !sim->processes[process]->active) 
+	return FALSE; 
+    q = sim->processes[process]; 
+    if (q->suspended) return TRUE; 
+    sim->pcstates[PCSTATE(sim, q->pages[PAGEOF(sim, q->pc)])]--; 
+    q->suspended=TRUE; sim->nsuspended++; sim->pagerbusy=TRUE; 
+    sim_log(sim,LOG_LOAD,"process %2d; pc %04d: suspended\n",process, q->pc); 
+    sim_event(sim, TR_SUSPEND, process, -1, q); 
+    return TRUE; 
+} 
+
+int sim_resume(Simulation *sim, int process) { 
+    Process *q; 
+    if (process<0 || process>=sim->procs || !sim->processes[process] 
+     || !sim->processes[process]->active) 
+	return FALSE; 
+    q = sim->processes[process]; 
+    if (!q->suspended) return TRUE; 
+    sim->pcstates[PCSTATE(sim, q->pages[PAGEOF(sim, q->pc)])]++; 
+    q->suspended=FALSE; sim->nsuspended--; sim->pagerbusy=TRUE; 
+    sim_log(sim,LOG_LOAD,"process %2d; pc %04d: resumed\n",process, q->pc); 
+    sim_event(sim, TR_RESUME, process, -1, q); 
+    return TRUE; 
+} 
+
+long sim_runtime(Simulation *sim, int process) { 
+    if (process<0 || process>=sim->procs || !sim->processes[process] 
+     || !sim->processes[process]->active) 
+	return -1; 
+    return sim->processes[process]->compute; 
+} 
+
+long sim_pageframe(Simulation *sim, int process, int page) { 
+    if (process<0 || process>=sim->procs || page<0 || page>=sim->maxpages) 
+	return -1; 
+    return sim->slotframe[process*sim->maxpages+page]; 
+} 
+
+int sim_frameowner(Simulation *sim, long frame, int *process, int *page) { 
+    long slot; 
+    if (frame<0 || frame>=sim->geometry.frames) return FALSE; 
+    slot = sim->frameslot[frame]; 
+    if (slot<0) return FALSE; 
+    if (process) *process = slot/sim->maxpages; 
+    if (page) *page = slot%sim->maxpages; 
+    return TRUE; 
+} 
+
+/* public routine: per-simulation storage for the pager */ 
+void *pagerstate(Simulation *sim, size_t size) { 
+    if (!sim->pagerdata) { 
+	sim->pagerdata = calloc(1, size); 
+	if (!sim->pagerdata) DIE("out of memory"); 
+    } 
+    return sim->pagerdata; 
+}
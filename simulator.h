@@ -13,9 +13,14 @@
  * 	This is the core simulator header file.
  */
 
+#include <stdio.h>
+#include <stddef.h>
+
 #define TRUE  1
 #define FALSE 0
 
+/* default geometry (see Simoptions); pageit() pagers always
+   see MAXPROCESSES entries of MAXPROCPAGES pages */
 #define MAXPROCPAGES 20 	/* max pages per individual process */ 
 #define MAXPROCESSES 20 	/* max number of processes in runqueue */ 
 #define PAGESIZE 128 		/* size of an individual page */ 
@@ -23,6 +28,15 @@
 #define PHYSICALPAGES 100	/* number of available physical pages */ 
 #define MAXPC (MAXPROCPAGES*PAGESIZE) /* largest PC value */ 
 
+/* logging ports */
+#define LOG_ALWAYS  (1<<0)
+#define LOG_LOAD    (1<<1)
+#define LOG_BLOCK   (1<<2)
+#define LOG_PAGE    (1<<3)
+#define LOG_BRANCH  (1<<4)
+#define LOG_DEAD    (1<<5)
+#define LOG_QUEUE   (1<<9)
+
 struct pentry {
     long active; 
     long pc; 
@@ -32,35 +46,326 @@ struct pentry {
 
 typedef struct pentry Pentry; 
 
-/* int pagein (int process, int page)
+/* all of the state of one simulation run (opaque) */
+typedef struct simulation Simulation; 
+
+/* int pagein (Simulation *sim, int process, int page)
  *   This pages in the requested page
  * Arguments:
- *   proc: process to work upon (0-19) 
- *   page: page to put in (0-19)
+ *   sim: simulation passed to pageit()
+ *   proc: process to work upon (0 to procs-1) 
+ *   page: page to put in (0 to maxpages-1)
  * Returns:
  *   1 if pagein started, already running, or paged in
- *   0 if it can't start (e.g., swapping out) 
+ *     (or waits for the swap device)
+ *   0 if it can't start (e.g., swapping out, no free
+ *     frame, or the swap device queue is full: see
+ *     sim_iobusy())
  */
-extern int pagein (int process, int page); 
+extern int pagein (Simulation *sim, int process, int page); 
 
-/* int pageout(int process, int page)
+/* int pageout(Simulation *sim, int process, int page)
  *   This pages out the requested page.
  * Arguments:
- *   proc: process to work upon (0-19)
+ *   sim: simulation passed to pageit()
+ *   proc: process to work upon (0 to procs-1)
  *   page: page to swap out. 
  * Returns: 
  *   1 if pageout started, already running, or paged out
+ *     (or waits for the swap device)
  *   0 if can't start (e.g., swapping in)
  */
-extern int pageout(int process, int page); 
+extern int pageout(Simulation *sim, int process, int page); 
+
+/* void *pagerstate(Simulation *sim, size_t size)
+ *   This returns storage for the pager's own state, so
+ *   that pageit() needs no statics. The storage is
+ *   zeroed when first requested and freed with the
+ *   simulation.
+ * Arguments:
+ *   sim: simulation passed to pageit()
+ *   size: size of the pager's state (same on every call)
+ * Returns:
+ *   pointer to the state of this simulation's pager
+ */
+extern void *pagerstate(Simulation *sim, size_t size); 
+
+/* long sim_nextuse(Simulation *sim, int process, int page)
+ *   This is an oracle for offline pagers such as opt.
+ *   Every branch a job takes is drawn when it is queued,
+ *   so the pages a process will visit are already known.
+ *   The first call for a process replays them once.
+ * Arguments:
+ *   sim: simulation passed to the pager
+ *   proc: process to look ahead in (0 to procs-1)
+ *   page: page asked about
+ * Returns:
+ *   compute ticks the process has left before it next
+ *   needs page (0 if it is on it now), or -1 if it
+ *   never needs it again
+ */
+extern long sim_nextuse(Simulation *sim, int process, int page);
+
+/* long sim_nextpage(Simulation *sim, int process, long *page)
+ *   This is the same oracle asked the other way around.
+ * Returns:
+ *   compute ticks the process has left before it moves
+ *   to another page, with that page in *page, or -1 if
+ *   it exits first
+ */
+extern long sim_nextpage(Simulation *sim, int process, long *page);
 
-/* void pageit(Pentry q[MAXPROCESSES])
+/* void pageit(Simulation *sim, Pentry q[MAXPROCESSES])
  *   This is called by the simulator
  *   every time something interesting occurs.
  *   It is where you implement the paging strategy.
  * Arguments:   
+ *   sim: simulation to pass to pagein(), pageout()
+ *        and pagerstate()
  *   q: state of every process
  * Returns:
  *   void 
  */
-extern void pageit(Pentry q[MAXPROCESSES]); 
+typedef void (*Pageit)(Simulation *sim, Pentry q[MAXPROCESSES]);
+
+/* changes reported to pageupdate() */
+#define PE_LOAD   0     /* process loaded; page is that of its pc */
+#define PE_UNLOAD 1     /* process exited; all its pages are free */
+#define PE_CROSS  2     /* pc moved to another page, resident or not */
+#define PE_FAULT  3     /* process blocked on page (reported once) */
+#define PE_IN     4     /* pagein of page ended */
+#define PE_OUT    5     /* pageout of page ended; its frame is free */
+#define PE_CANCEL 6     /* pagein of page, still waiting for the swap
+                           device, was cancelled for a demand fault;
+                           page and frame are free */
+
+struct pevent {
+    int type;           /* PE_* */
+    int proc;           /* process (0 to procs-1) */
+    int page;           /* page concerned */
+    long pc;            /* pc of the process */
+};
+
+typedef struct pevent Pevent;
+
+/* void pageupdate(Simulation *sim, const Pevent *events, long nevents)
+ *   This is called by the simulator every tick, in place
+ *   of building the Pentry snapshot for pageit(), with
+ *   what changed since the previous call, in order.
+ *   There may be no changes at all.
+ * Arguments:
+ *   sim: simulation to pass to pagein(), pageout()
+ *        and pagerstate()
+ *   events, nevents: the changes
+ * Returns:
+ *   void
+ */
+typedef void (*Pageupdate)(Simulation *sim, const Pevent *events, long nevents);
+
+/* a paging strategy, registered in pagers.c; either or both
+   entry points may be given, and pageupdate() is called first */
+struct pager {
+    const char *name;   /* name given to -pager */
+    Pageit pageit;      /* the strategy, or NULL */
+    Pageupdate pageupdate; /* the strategy driven by changes, or NULL */
+};
+
+typedef struct pager Pager; 
+
+/* registered pagers, terminated by NULL */
+extern const Pager *pagers[]; 
+
+/* const Pager *pager_find(const char *name)
+ *   This finds a registered pager by name. A name
+ *   containing '/' is instead loaded as a shared object
+ *   that defines either 'const Pager pager' or a plain
+ *   'void pageit(Simulation *sim, Pentry q[MAXPROCESSES])',
+ *   a plain 'void pageupdate(...)', or both.
+ * Arguments:
+ *   name: pager name or path of a shared object
+ * Returns:
+ *   the pager, or NULL if there is no such pager
+ */
+extern const Pager *pager_find(const char *name); 
+
+/* orders of the requests waiting for the swap device; a demand 
+   request is a pagein of the page under its process's pc, or a 
+   pageout. With DEMAND and DEADLINE, a demand pagein that finds 
+   no frame or a full queue cancels the newest waiting prefetch 
+   (see PE_CANCEL) */ 
+#define IOSCHED_FIFO     0      /* oldest first */
+#define IOSCHED_DEMAND   1      /* demand before prefetch, oldest first */
+#define IOSCHED_DEADLINE 2      /* demand first, unless a prefetch has
+                                   waited iodeadline ticks */
+
+/* long iosched_find(const char *name)
+ *   This returns the IOSCHED_* called name ("fifo", "demand"
+ *   or "deadline"), or -1 if there is none.
+ */
+extern long iosched_find(const char *name); 
+
+/* options of one simulation run */
+struct simoptions {
+    const Pager *pager; /* paging strategy */
+    long seed;          /* random seed (1 to 2^30-1) */
+    long procs;         /* number of processors (MAXPROCESSES) */
+    long frames;        /* number of available physical pages */
+    long pagesize;      /* size of an individual page (PAGESIZE) */
+    long maxpages;      /* pages per process (MAXPROCPAGES) */
+    long pagewait;      /* ticks to page in or out (PAGEWAIT) */
+    long readwait;      /* swap device: ticks to page in, */
+    long writewait;     /* ... and out (0 for pagewait) */
+    long channels;      /* ... transfers at once (0 for any number) */
+    long bandwidth;     /* ... pages per 1000 ticks (0 for no cap) */
+    long ioqueue;       /* ... requests that may wait for it before
+                           pageins are refused (0 for any number) */
+    long iosched;       /* ... order of waiting requests (IOSCHED_*) */
+    long iodeadline;    /* ... ticks a prefetch may wait behind demand
+                           requests with IOSCHED_DEADLINE (0 for
+                           readwait) */
+    long warp;          /* skip ticks in which nothing can change */
+    long giveup;        /* end a run after this many ticks in which no
+                           process can run and no page moves (0 never) */
+    long log;           /* logging ports (LOG_*) */
+    FILE *output;       /* PC history (output.csv) or NULL */
+    FILE *pages;        /* block allocation history (pages.csv) or NULL */
+    struct tracewriter *trace; /* binary trace (see trace.h) or NULL */
+    FILE *stats;        /* metrics at the end (see stats.h) or NULL */
+    long statscsv;      /* write them as csv rather than JSON */
+    long timing;        /* report wall time per phase of a tick */
+    const struct workload *workload; /* recorded pcs (see workload.h),
+                                        or NULL to run the programs */
+    const struct program *programs; /* programs to run (see program.h), */
+    long nprograms;                 /* or NULL for those of programs.c */
+};
+
+typedef struct simoptions Simoptions; 
+
+/* void sim_defaults(Simoptions *opt)
+ *   This fills in the options of a run without arguments.
+ */
+extern void sim_defaults(Simoptions *opt); 
+
+/* const char *sim_check(const Simoptions *opt)
+ *   This checks that a run is possible: the geometry is
+ *   in range, every program or workload pc fits in its
+ *   pages, and a pager with pageit() gets a geometry that
+ *   fits a Pentry (pageupdate() pagers take any).
+ * Returns:
+ *   what is wrong, or NULL if sim_create() may be called
+ */
+extern const char *sim_check(const Simoptions *opt); 
+
+/* Simulation *sim_create(const Simoptions *opt)
+ *   This creates an independent simulation. Runs
+ *   with the same seed see the same job queue.
+ * Arguments:
+ *   opt: options of the run; the simulation closes
+ *        the csv files, the trace and the metrics
+ *        file when destroyed
+ * Returns:
+ *   the new simulation
+ */
+extern Simulation *sim_create(const Simoptions *opt); 
+
+/* the geometry of a run, for pagers that size their state by it */
+struct geometry {
+    long procs;         /* number of processors */
+    long maxpages;      /* pages per process */
+    long pagesize;      /* size of an individual page */
+    long pagewait;      /* ticks to page in or out, as asked */
+    long frames;        /* number of physical pages */
+    long readwait;      /* ticks a pagein takes on the device */
+    long writewait;     /* ticks a pageout takes on the device */
+    long channels;      /* swap device limits (see Simoptions) */
+    long bandwidth;
+    long ioqueue;
+    long iosched;
+};
+
+typedef struct geometry Geometry; 
+
+/* const Geometry *sim_geometry(Simulation *sim)
+ *   This returns the geometry of a run; pagers call it
+ *   before pagerstate() to size their state.
+ */
+extern const Geometry *sim_geometry(Simulation *sim); 
+
+/* int sim_iobusy(Simulation *sim)
+ *   This returns 1 if the swap device queue is full, so
+ *   that pagein() would be refused until a transfer ends;
+ *   a pager can stop prefetching then. Pageouts are
+ *   always let wait.
+ *
+ * long sim_ioqueued(Simulation *sim)
+ *   This returns the number of requests waiting for the
+ *   swap device. Their pages count as coming in or going
+ *   out, but their wait starts only when they reach it;
+ *   a waiting prefetch may be cancelled (PE_CANCEL).
+ */
+extern int sim_iobusy(Simulation *sim); 
+extern long sim_ioqueued(Simulation *sim); 
+
+/* long sim_freeframes(Simulation *sim)
+ *   This returns the number of free physical frames.
+ *
+ * long sim_pageframe(Simulation *sim, int process, int page)
+ *   This returns the frame (0 to frames-1) that holds page
+ *   of process, from the start of its pagein to the end of
+ *   its pageout, or -1 if it has none.
+ *
+ * int sim_frameowner(Simulation *sim, long frame, int *process, int *page)
+ *   This is the reverse map: if frame is in use, it sets
+ *   *process and *page (either may be NULL) to what it
+ *   holds and returns 1; a free frame returns 0. A pager
+ *   can walk frames 0 to frames-1 to see every page in
+ *   memory without scanning every process.
+ */
+extern long sim_freeframes(Simulation *sim); 
+extern long sim_pageframe(Simulation *sim, int process, int page); 
+extern int sim_frameowner(Simulation *sim, long frame, int *process, int *page); 
+
+/* int sim_suspend(Simulation *sim, int process)
+ * int sim_resume(Simulation *sim, int process)
+ *   These hold a process back from running, and let it run
+ *   again: for load control, so that only processes whose
+ *   pages fit in memory compete for it. A suspended process
+ *   keeps its pages (they may be paged in or out), its ticks
+ *   count as blocked, and it reports nothing until resumed;
+ *   a fault it was blocked on is not reported again. A run
+ *   ends only once every process is resumed and exits.
+ * Returns:
+ *   1 on success (or if already so), 0 if there is no
+ *   active process there
+ *
+ * long sim_runtime(Simulation *sim, int process)
+ *   This returns the compute ticks a process has run, its
+ *   virtual time (as for a working set), or -1 if there is
+ *   no active process there.
+ */
+extern int sim_suspend(Simulation *sim, int process); 
+extern int sim_resume(Simulation *sim, int process); 
+extern long sim_runtime(Simulation *sim, int process); 
+
+/* void sim_run(Simulation *sim)
+ *   This runs a simulation until its job queue is empty.
+ */
+extern void sim_run(Simulation *sim); 
+
+/* long sim_blocked(Simulation *sim)
+ * long sim_compute(Simulation *sim)
+ *   These return the blocked and compute cycles
+ *   of every job, as reported at the end of a run.
+ */
+extern long sim_blocked(Simulation *sim); 
+extern long sim_compute(Simulation *sim); 
+
+/* void sim_print(Simulation *sim)
+ *   This prints the page state of every process.
+ */
+extern void sim_print(Simulation *sim); 
+
+/* void sim_destroy(Simulation *sim)
+ *   This releases a simulation and its pager state.
+ */
+extern void sim_destroy(Simulation *sim);  
@@ -0,0 +1,282 @@
+/*
+ * File: stats.c
+ *
+ * Project: CSCI 3753 Programming Assignment 4
+ * Create Date: 2026/10/16
+ * Modify Date: 2026/10/16
+ * Description:
+ * 	This gathers the metrics of one run as the simulator
+ *      reports to it, and writes them as JSON or csv.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+
+#include "stats.h"
+
+/* what is known of one page of a process */
+#define PG_IN       1 	/* paged in (or coming) */
+#define PG_PREFETCH 2 	/* ... while its process was on another page */
+#define PG_USED     4 	/* ... and run on since */
+
+/* counters of one process, or summed over a kind */
+typedef struct counts {
+    long processes;
+    long compute, block;
+    long faults;
+    long pageins, prefetches, rejected, pageouts;
+    long cancelled;         /* pageins cancelled while waiting */
+    long prefetchhits;      /* prefetched pages run on */
+    long wastedprefetches;  /* prefetched pages freed unused */
+    long evictedunused;     /* pages paged out before they were run on */
+    long stalls[STALLBUCKETS];
+} Counts;
+
+typedef struct sample {
+    long clock, resident, inflight;
+} Sample;
+
+struct stats {
+    long nprocs, maxpages;
+    Counts *procs;
+    long *kinds;            /* kind of each process, or -1 */
+    long *blockedat;        /* clock of each open stall, or -1 */
+    long *pagefaults;       /* nprocs*maxpages */
+    unsigned char *pages;   /* PG_* of nprocs*maxpages */
+    Sample *samples;
+    long nsamples, maxsamples;
+};
+
+Stats *stats_create(long nprocs, long maxpages) {
+    long i;
+    Stats *s = calloc(1, sizeof(Stats));
+    if (!s) return NULL;
+    s->nprocs = nprocs;
+    s->maxpages = maxpages;
+    s->procs = calloc(nprocs, sizeof(Counts));
+    s->kinds = malloc(nprocs*sizeof(long));
+    s->blockedat = malloc(nprocs*sizeof(long));
+    s->pagefaults = calloc(nprocs*maxpages, sizeof(long));
+    s->pages = calloc(nprocs*maxpages, 1);
+    if (!s->procs || !s->kinds || !s->blockedat || !s->pagefaults || !s->pages) {
+        stats_free(s);
+        return NULL;
+    }
+    for (i=0; i<nprocs; i++) s->kinds[i] = s->blockedat[i] = -1;
+    return s;
+}
+
+void stats_load(Stats *s, long pid, long kind) {
+    s->kinds[pid] = kind;
+    s->procs[pid].processes = 1;
+}
+
+void stats_fault(Stats *s, long pid, long page, long clock) {
+    s->procs[pid].faults++;
+    s->pagefaults[pid*s->maxpages+page]++;
+    s->blockedat[pid] = clock;
+}
+
+void stats_unblock(Stats *s, long pid, long clock) {
+    long k, ticks;
+    if (s->blockedat[pid] < 0) return;
+    ticks = clock - s->blockedat[pid];
+    for (k=0; k<STALLBUCKETS-1 && ticks >= 2L<<k; k++) ;
+    s->procs[pid].stalls[k]++;
+    s->blockedat[pid] = -1;
+}
+
+void stats_use(Stats *s, long pid, long page) {
+    unsigned char *p = s->pages + pid*s->maxpages + page;
+    if ((*p & PG_IN) && !(*p & PG_USED)) {
+        *p |= PG_USED;
+        if (*p & PG_PREFETCH) s->procs[pid].prefetchhits++;
+    }
+}
+
+void stats_pagein(Stats *s, long pid, long page, int prefetch) {
+    s->procs[pid].pageins++;
+    if (prefetch) s->procs[pid].prefetches++;
+    s->pages[pid*s->maxpages+page] = PG_IN | (prefetch ? PG_PREFETCH : 0);
+}
+
+void stats_reject(Stats *s, long pid) {
+    s->procs[pid].rejected++;
+}
+
+/* a page leaves memory: was it ever run on? */
+static void stats_free_page(Stats *s, long pid, long page, int evicted) {
+    unsigned char *p = s->pages + pid*s->maxpages + page;
+    if ((*p & PG_IN) && !(*p & PG_USED)) {
+        if (evicted) s->procs[pid].evictedunused++;
+        if (*p & PG_PREFETCH) s->procs[pid].wastedprefetches++;
+    }
+    *p = 0;
+}
+
+void stats_pageout(Stats *s, long pid, long page) {
+    s->procs[pid].pageouts++;
+    stats_free_page(s, pid, page, 1);
+}
+
+void stats_cancel(Stats *s, long pid, long page) {
+    s->procs[pid].cancelled++;
+    s->pages[pid*s->maxpages+page] = 0;
+}
+
+void stats_unload(Stats *s, long pid, long compute, long block) {
+    long page;
+    for (page=0; page<s->maxpages; page++) stats_free_page(s, pid, page, 0);
+    s->procs[pid].compute = compute;
+    s->procs[pid].block = block;
+}
+
+void stats_sample(Stats *s, long clock, long resident, long inflight) {
+    if (s->nsamples == s->maxsamples) {
+        long n = s->maxsamples ? 2*s->maxsamples : 64;
+        Sample *grown = realloc(s->samples, n*sizeof(Sample));
+        if (!grown) return; /* keep what we have */
+        s->samples = grown;
+        s->maxsamples = n;
+    }
+    s->samples[s->nsamples].clock = clock;
+    s->samples[s->nsamples].resident = resident;
+    s->samples[s->nsamples++].inflight = inflight;
+}
+
+static void counts_add(Counts *to, const Counts *c) {
+    long k;
+    to->processes += c->processes;
+    to->compute += c->compute;
+    to->block += c->block;
+    to->faults += c->faults;
+    to->pageins += c->pageins;
+    to->prefetches += c->prefetches;
+    to->rejected += c->rejected;
+    to->pageouts += c->pageouts;
+    to->cancelled += c->cancelled;
+    to->prefetchhits += c->prefetchhits;
+    to->wastedprefetches += c->wastedprefetches;
+    to->evictedunused += c->evictedunused;
+    for (k=0; k<STALLBUCKETS; k++) to->stalls[k] += c->stalls[k];
+}
+
+static void counts_json(FILE *f, const Counts *c) {
+    long k;
+    fprintf(f, "\"processes\": %ld, \"compute\": %ld, \"blocked\": %ld, "
+            "\"faults\": %ld, \"pageins\": %ld, \"prefetches\": %ld, "
+            "\"rejected\": %ld, \"pageouts\": %ld, \"cancelled\": %ld, "
+            "\"prefetch_hits\": %ld, \"wasted_prefetches\": %ld, "
+            "\"evicted_unused\": %ld, \"stalls\": [",
+            c->processes, c->compute, c->block, c->faults, c->pageins,
+            c->prefetches, c->rejected, c->pageouts, c->cancelled, c->prefetchhits,
+            c->wastedprefetches, c->evictedunused);
+    for (k=0; k<STALLBUCKETS; k++) fprintf(f, "%s%ld", k ? ", " : "", c->stalls[k]);
+    fprintf(f, "]");
+}
+
+static void counts_csv(FILE *f, const Counts *c) {
+    long k;
+    fprintf(f, "%ld,%ld,%ld,%ld,%ld,%ld,%ld,%ld,%ld,%ld,%ld,%ld",
+            c->processes, c->compute, c->block, c->faults, c->pageins,
+            c->prefetches, c->rejected, c->pageouts, c->cancelled, c->prefetchhits,
+            c->wastedprefetches, c->evictedunused);
+    for (k=0; k<STALLBUCKETS; k++) fprintf(f, ",%ld", c->stalls[k]);
+    fprintf(f, "\n");
+}
+
+static int long_cmp(const void *a, const void *b) {
+    long x = *(const long *)a, y = *(const long *)b;
+    return x < y ? -1 : x > y;
+}
+
+void stats_write(Stats *s, FILE *f, int csv, const char *pager, long seed) {
+    long i, j, k, nkinds = 0;
+    long *ids, *id;
+    Counts *kinds, total;
+
+    /* the kinds of the processes loaded, in order; kinds come from
+       workload files and -programs, so they may be sparse */
+    ids = malloc((s->nprocs ? s->nprocs : 1)*sizeof(long));
+    kinds = calloc(s->nprocs ? s->nprocs : 1, sizeof(Counts));
+    if (!ids || !kinds) {
+        fprintf(stderr, "stats: out of memory\n");
+        exit(EXIT_FAILURE);
+    }
+    for (i=0; i<s->nprocs; i++)
+        if (s->kinds[i] >= 0) ids[nkinds++] = s->kinds[i];
+    qsort(ids, nkinds, sizeof(long), long_cmp);
+    for (i=0, j=0; i<nkinds; i++)
+        if (j == 0 || ids[i] != ids[j-1]) ids[j++] = ids[i];
+    nkinds = j;
+    memset(&total, 0, sizeof(total));
+    for (i=0; i<s->nprocs; i++) {
+        if (s->kinds[i] < 0) continue; /* never loaded */
+        id = bsearch(s->kinds+i, ids, nkinds, sizeof(long), long_cmp);
+        counts_add(kinds+(id-ids), s->procs+i);
+        counts_add(&total, s->procs+i);
+    }
+
+    if (csv) {
+        fprintf(f, "pager,seed,scope,id,processes,compute,blocked,faults,pageins,"
+                "prefetches,rejected,pageouts,cancelled,prefetch_hits,wasted_prefetches,"
+                "evicted_unused");
+        for (k=0; k<STALLBUCKETS; k++) fprintf(f, ",stall%ld", 1L<<k);
+        fprintf(f, "\n");
+        for (i=0; i<s->nprocs; i++) {
+            if (s->kinds[i] < 0) continue;
+            fprintf(f, "%s,%ld,process,%ld,", pager, seed, i);
+            counts_csv(f, s->procs+i);
+        }
+        for (i=0; i<nkinds; i++) {
+            fprintf(f, "%s,%ld,kind,%ld,", pager, seed, ids[i]);
+            counts_csv(f, kinds+i);
+        }
+        fprintf(f, "%s,%ld,total,0,", pager, seed);
+        counts_csv(f, &total);
+        free(ids);
+        free(kinds);
+        return;
+    }
+
+    fprintf(f, "{\n  \"pager\": \"%s\",\n  \"seed\": %ld,\n", pager, seed);
+    fprintf(f, "  \"stall_buckets\": [");
+    for (k=0; k<STALLBUCKETS; k++) fprintf(f, "%s%ld", k ? ", " : "", 1L<<k);
+    fprintf(f, "],\n  \"total\": { ");
+    counts_json(f, &total);
+    fprintf(f, " },\n  \"kinds\": [\n");
+    for (i=0; i<nkinds; i++) {
+        fprintf(f, "    { \"kind\": %ld, ", ids[i]);
+        counts_json(f, kinds+i);
+        fprintf(f, " }%s\n", i+1<nkinds ? "," : "");
+    }
+    fprintf(f, "  ],\n  \"processes\": [\n");
+    for (i=0, j=0; i<s->nprocs; i++) {
+        if (s->kinds[i] < 0) continue;
+        fprintf(f, "%s    { \"pid\": %ld, \"kind\": %ld, ", j++ ? ",\n" : "", i, s->kinds[i]);
+        counts_json(f, s->procs+i);
+        fprintf(f, ", \"page_faults\": [");
+        for (k=0; k<s->maxpages; k++)
+            fprintf(f, "%s%ld", k ? ", " : "", s->pagefaults[i*s->maxpages+k]);
+        fprintf(f, "] }");
+    }
+    fprintf(f, "\n  ],\n  \"resident\": [\n");
+    for (i=0; i<s->nsamples; i++)
+        fprintf(f, "    { \"clock\": %ld, \"resident\": %ld, \"inflight\": %ld }%s\n",
+                s->samples[i].clock, s->samples[i].resident, s->samples[i].inflight,
+                i+1<s->nsamples ? "," : "");
+    fprintf(f, "  ]\n}\n");
+    free(ids);
+    free(kinds);
+}
+
+void stats_free(Stats *s) {
+    free(s->procs);
+    free(s->kinds);
+    free(s->blockedat);
+    free(s->pagefaults);
+    free(s->pages);
+    free(s->samples);
+    free(s);
+}
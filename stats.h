@@ -0,0 +1,83 @@
+/*
+ * File: stats.h
+ *
+ * Project: CSCI 3753 Programming Assignment 4
+ * Create Date: 2026/10/16
+ * Modify Date: 2026/10/16
+ * Description:
+ * 	These are the metrics -stats writes at the end of a run:
+ *      per process and per program kind fault counts, stall
+ *      time histograms, pagein and prefetch outcomes, and the
+ *      resident set size over time. The simulator reports to
+ *      them as it runs; processes are numbered by their place
+ *      in the job queue.
+ */
+
+#define STALLBUCKETS 16 	/* stalls of 2^k to 2^(k+1)-1 ticks; the last
+				   bucket takes the longer ones */
+#define STATSINTERVAL 1000 	/* ticks between resident set samples */
+
+typedef struct stats Stats;
+
+/* Stats *stats_create(long nprocs, long maxpages)
+ *   This creates empty metrics for a job queue of nprocs
+ *   processes of maxpages pages each.
+ */
+extern Stats *stats_create(long nprocs, long maxpages);
+
+/* void stats_load(Stats *s, long pid, long kind)
+ *   Process pid, of program kind, was loaded.
+ */
+extern void stats_load(Stats *s, long pid, long kind);
+
+/* void stats_fault(Stats *s, long pid, long page, long clock)
+ * void stats_unblock(Stats *s, long pid, long clock)
+ *   Process pid blocked on page, or ran again after it.
+ */
+extern void stats_fault(Stats *s, long pid, long page, long clock);
+extern void stats_unblock(Stats *s, long pid, long clock);
+
+/* void stats_use(Stats *s, long pid, long page)
+ *   Process pid ran on a page that had been paged in.
+ */
+extern void stats_use(Stats *s, long pid, long page);
+
+/* void stats_pagein(Stats *s, long pid, long page, int prefetch)
+ * void stats_reject(Stats *s, long pid)
+ * void stats_pageout(Stats *s, long pid, long page)
+ *   A pagein started, for a page the process was not on if
+ *   prefetch; a pagein was refused; a pageout started.
+ */
+extern void stats_pagein(Stats *s, long pid, long page, int prefetch);
+extern void stats_reject(Stats *s, long pid);
+extern void stats_pageout(Stats *s, long pid, long page);
+
+/* void stats_cancel(Stats *s, long pid, long page)
+ *   A pagein still waiting for the swap device was
+ *   cancelled; the page is free again.
+ */
+extern void stats_cancel(Stats *s, long pid, long page);
+
+/* void stats_unload(Stats *s, long pid, long compute, long block)
+ *   Process pid exited after compute and block ticks; its
+ *   pages are freed.
+ */
+extern void stats_unload(Stats *s, long pid, long compute, long block);
+
+/* void stats_sample(Stats *s, long clock, long resident, long inflight)
+ *   Frames resident and paging in or out at clock.
+ */
+extern void stats_sample(Stats *s, long clock, long resident, long inflight);
+
+/* void stats_write(Stats *s, FILE *f, int csv, const char *pager, long seed)
+ *   This writes the metrics as one JSON object, or as csv
+ *   rows of one process or kind each (csv leaves out the
+ *   per page faults and the resident set samples). Only
+ *   kinds that ran are listed, in increasing order.
+ */
+extern void stats_write(Stats *s, FILE *f, int csv, const char *pager, long seed);
+
+/* void stats_free(Stats *s)
+ *   This releases the metrics.
+ */
+extern void stats_free(Stats *s);
@@ -0,0 +1,396 @@
+/*
+ * File: sweep.c
+ *
+ * Project: CSCI 3753 Programming Assignment 4
+ * Create Date: 2026/10/16
+ * Modify Date: 2026/10/16
+ * Description:
+ * 	This is a parameter sweep driver: it runs every combination
+ *      of pager, seed, number of processors and physical page
+ *      budget, spreading the runs across all cores, and prints the
+ *      mean blocked/compute ratio of each combination with its
+ *      standard deviation and 95% confidence interval.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <math.h>
+#include <unistd.h>
+#include <pthread.h>
+
+#include "simulator.h"
+#include "workload.h"
+#include "program.h"
+
+#define MAXVALUES 64 	/* values of one swept parameter */
+
+/* one simulation run of the sweep */
+typedef struct job {
+    const Pager *pager;
+    long seed;
+    long procs;
+    long frames;
+    long blocked;
+    long compute;
+} Job;
+
+/* per-worker double ended queue of job indices: the owner
+   takes from the tail, idle workers steal from the head */
+typedef struct deque {
+    pthread_mutex_t lock;
+    long *jobs;
+    long head, tail;
+} Deque;
+
+static Job *jobs;
+static long njobs;
+static Deque *deques;
+static long nworkers;
+static long warp = TRUE;
+static long pagesize = PAGESIZE;
+static long maxpages = MAXPROCPAGES;
+static long pagewait = PAGEWAIT;
+static long readwait, writewait, channels, bandwidth, ioqueue; /* swap device */
+static long iosched = IOSCHED_FIFO, iodeadline;
+static Workload *workload;
+static Program *programs;
+static long nprograms;
+
+static long deque_pop(Deque *d) {
+    long job = -1;
+    pthread_mutex_lock(&d->lock);
+    if (d->head < d->tail) job = d->jobs[--d->tail];
+    pthread_mutex_unlock(&d->lock);
+    return job;
+}
+
+static long deque_steal(Deque *d) {
+    long job = -1;
+    pthread_mutex_lock(&d->lock);
+    if (d->head < d->tail) job = d->jobs[d->head++];
+    pthread_mutex_unlock(&d->lock);
+    return job;
+}
+
+static void job_options(Job *job, Simoptions *opt) {
+    sim_defaults(opt);
+    opt->pager = job->pager;
+    opt->seed = job->seed;
+    opt->procs = job->procs;
+    opt->frames = job->frames;
+    opt->pagesize = pagesize;
+    opt->maxpages = maxpages;
+    opt->pagewait = pagewait;
+    opt->readwait = readwait;
+    opt->writewait = writewait;
+    opt->channels = channels;
+    opt->bandwidth = bandwidth;
+    opt->ioqueue = ioqueue;
+    opt->iosched = iosched;
+    opt->iodeadline = iodeadline;
+    opt->warp = warp;
+    opt->workload = workload;
+    opt->programs = programs;
+    opt->nprograms = nprograms;
+    opt->log = 0;
+}
+
+static void job_run(Job *job) {
+    Simoptions opt;
+    Simulation *sim;
+    job_options(job, &opt);
+    sim = sim_create(&opt);
+    sim_run(sim);
+    job->blocked = sim_blocked(sim);
+    job->compute = sim_compute(sim);
+    sim_destroy(sim);
+}
+
+/* run own jobs, then steal from the others until all are empty;
+   no job creates new jobs, so one empty pass means we are done */
+static void *worker(void *arg) {
+    long self = (long)arg;
+    long i, job;
+    for (;;) {
+        job = deque_pop(deques+self);
+        for (i=1; job<0 && i<nworkers; i++)
+            job = deque_steal(deques+(self+i)%nworkers);
+        if (job<0) break;
+        job_run(jobs+job);
+    }
+    return NULL;
+}
+
+/* two-sided 95% critical values of Student's t for 1..30 degrees
+   of freedom; the normal value 1.96 is used beyond that */
+static double t95(long df) {
+    static const double t[30] = {
+        12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+        2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+        2.080, 2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042,
+    };
+    if (df < 1) return 0.0;
+    if (df <= 30) return t[df-1];
+    return 1.96;
+}
+
+/* read a comma separated list of values */
+static long parse_list(const char *arg, long *values) {
+    long n = 0;
+    const char *p = arg;
+    char *end;
+    while (*p && n < MAXVALUES) {
+        values[n++] = strtol(p, &end, 10);
+        if (end == p) return 0;
+        p = end;
+        if (*p == ',') p++;
+        else if (*p) return 0;
+    }
+    return n;
+}
+
+int main(int argc, char **argv) {
+    long i, j, k, p, s, errors=0, help=0;
+    long seed=1, seeds=10;
+    const Pager *pager[MAXVALUES];
+    long npagers=0;
+    long procs[MAXVALUES] = { MAXPROCESSES }, nprocs=1;
+    long frames[MAXVALUES] = { PHYSICALPAGES }, nframes=1;
+    pthread_t *threads;
+
+    nworkers = sysconf(_SC_NPROCESSORS_ONLN);
+    for (i=1; i<argc; i++) {
+        if (strcmp(argv[i],"-help")==0) {
+            help++;
+        } else if (strcmp(argv[i],"-nowarp")==0) {
+            warp = FALSE;
+        } else if (strcmp(argv[i],"-workload")==0 && i+1<argc) {
+            if (workload) workload_close(workload);
+            if (!(workload = workload_open(argv[++i]))) errors++;
+        } else if (strcmp(argv[i],"-programs")==0 && i+1<argc) {
+            char *name = strtok(argv[++i], ",");
+            for (; name; name = strtok(NULL, ","))
+                if (!pseudo_load(name, &programs, &nprograms)) errors++;
+        } else if (strcmp(argv[i],"-pager")==0 && i+1<argc) {
+            char *name = strtok(argv[++i], ",");
+            for (; name; name = strtok(NULL, ",")) {
+                if (npagers >= MAXVALUES) {
+                    fprintf(stderr, "%s: at most %d pagers\n", argv[0], MAXVALUES);
+                    errors++;
+                } else if (!(pager[npagers++] = pager_find(name))) {
+                    fprintf(stderr, "%s: unknown pager %s\n", argv[0], name);
+                    errors++;
+                }
+            }
+        } else if (strcmp(argv[i],"-seed")==0 && i+1<argc) {
+            if (sscanf(argv[++i],"%ld",&seed)!=1 || seed<1) {
+                fprintf(stderr, "%s: bad first seed %s\n", argv[0], argv[i]);
+                errors++;
+            }
+        } else if (strcmp(argv[i],"-seeds")==0 && i+1<argc) {
+            if (sscanf(argv[++i],"%ld",&seeds)!=1 || seeds<1) {
+                fprintf(stderr, "%s: bad number of seeds %s\n", argv[0], argv[i]);
+                errors++;
+            }
+        } else if (strcmp(argv[i],"-threads")==0 && i+1<argc) {
+            if (sscanf(argv[++i],"%ld",&nworkers)!=1 || nworkers<1) {
+                fprintf(stderr, "%s: bad number of threads %s\n", argv[0], argv[i]);
+                errors++;
+            }
+        } else if (strcmp(argv[i],"-procs")==0 && i+1<argc) {
+            if (!(nprocs = parse_list(argv[++i], procs))) {
+                fprintf(stderr, "%s: bad processor list %s\n", argv[0], argv[i]);
+                errors++;
+            }
+        } else if (strcmp(argv[i],"-frames")==0 && i+1<argc) {
+            if (!(nframes = parse_list(argv[++i], frames))) {
+                fprintf(stderr, "%s: bad page budget list %s\n", argv[0], argv[i]);
+                errors++;
+            }
+            for (j=0; j<nframes; j++) if (frames[j]<1) {
+                fprintf(stderr, "%s: page budgets must be positive\n", argv[0]);
+                errors++;
+            }
+        } else if (strcmp(argv[i],"-pagesize")==0 && i+1<argc) {
+            if (sscanf(argv[++i],"%ld",&pagesize)!=1) {
+                fprintf(stderr, "%s: bad page size %s\n", argv[0], argv[i]);
+                errors++;
+            }
+        } else if (strcmp(argv[i],"-maxpages")==0 && i+1<argc) {
+            if (sscanf(argv[++i],"%ld",&maxpages)!=1) {
+                fprintf(stderr, "%s: bad pages per process %s\n", argv[0], argv[i]);
+                errors++;
+            }
+        } else if (strcmp(argv[i],"-pagewait")==0 && i+1<argc) {
+            if (sscanf(argv[++i],"%ld",&pagewait)!=1) {
+                fprintf(stderr, "%s: bad page wait %s\n", argv[0], argv[i]);
+                errors++;
+            }
+        } else if (strcmp(argv[i],"-iosched")==0 && i+1<argc) {
+            if ((iosched = iosched_find(argv[++i]))<0) {
+                fprintf(stderr, "%s: unknown swap device scheduler %s\n", argv[0], argv[i]);
+                errors++;
+            }
+        } else if (strcmp(argv[i],"-iodeadline")==0 && i+1<argc) {
+            if (sscanf(argv[++i],"%ld",&iodeadline)!=1) {
+                fprintf(stderr, "%s: bad prefetch deadline %s\n", argv[0], argv[i]);
+                errors++;
+            }
+        } else if (strcmp(argv[i],"-readwait")==0 && i+1<argc) {
+            if (sscanf(argv[++i],"%ld",&readwait)!=1) {
+                fprintf(stderr, "%s: bad read wait %s\n", argv[0], argv[i]);
+                errors++;
+            }
+        } else if (strcmp(argv[i],"-writewait")==0 && i+1<argc) {
+            if (sscanf(argv[++i],"%ld",&writewait)!=1) {
+                fprintf(stderr, "%s: bad write wait %s\n", argv[0], argv[i]);
+                errors++;
+            }
+        } else if (strcmp(argv[i],"-channels")==0 && i+1<argc) {
+            if (sscanf(argv[++i],"%ld",&channels)!=1) {
+                fprintf(stderr, "%s: bad number of channels %s\n", argv[0], argv[i]);
+                errors++;
+            }
+        } else if (strcmp(argv[i],"-bandwidth")==0 && i+1<argc) {
+            if (sscanf(argv[++i],"%ld",&bandwidth)!=1) {
+                fprintf(stderr, "%s: bad bandwidth %s\n", argv[0], argv[i]);
+                errors++;
+            }
+        } else if (strcmp(argv[i],"-ioqueue")==0 && i+1<argc) {
+            if (sscanf(argv[++i],"%ld",&ioqueue)!=1) {
+                fprintf(stderr, "%s: bad queue length %s\n", argv[0], argv[i]);
+                errors++;
+            }
+        } else {
+            fprintf(stderr, "%s: unrecognized argument %s\n", argv[0], argv[i]);
+            errors++;
+        }
+    }
+    if (seeds > (1<<30)-seed) {
+        // the last seed must be one simulate -seed would take too...
+        fprintf(stderr, "%s: %ld seeds from %ld run past the last seed %d\n",
+                argv[0], seeds, seed, (1<<30)-1);
+        errors++;
+    }
+    if (!npagers) pager[npagers++] = pager_find("lru");
+    for (p=0; p<npagers && !errors; p++) {
+        if (strcmp(pager[p]->name, "api") == 0) {
+            // it exits when its test ends, taking every worker with it...
+            fprintf(stderr, "%s: pager api ends the process; run it with simulate\n", argv[0]);
+            errors++;
+            break;
+        }
+        for (i=0; i<nprocs; i++) {
+            Job job;
+            Simoptions opt;
+            const char *why;
+            job.pager = pager[p];
+            job.seed = seed;
+            job.procs = procs[i];
+            job.frames = frames[0];
+            job_options(&job, &opt);
+            if ((why = sim_check(&opt))) {
+                fprintf(stderr, "%s: pager %s, %ld processors: %s\n",
+                        argv[0], pager[p]->name, procs[i], why);
+                errors++;
+            }
+        }
+    }
+    if (errors || help) {
+        fprintf(stderr, "%s usage: %s \n", argv[0], argv[0]);
+        fprintf(stderr, "  -pager lru,basic   pagers to sweep (default lru):");
+        for (i=0; pagers[i]; i++)
+            if (strcmp(pagers[i]->name, "api") != 0) fprintf(stderr, " %s", pagers[i]->name);
+        fprintf(stderr, "\n");
+        fprintf(stderr, "  -seed 512          first random seed (default 1)\n");
+        fprintf(stderr, "  -seeds 100         run 100 consecutive seeds (default 10)\n");
+        fprintf(stderr, "  -procs 5,10,20     numbers of processors to sweep\n");
+        fprintf(stderr, "  -frames 50,100     physical page budgets to sweep\n");
+        fprintf(stderr, "  -pagesize 64       page size (default %d)\n", PAGESIZE);
+        fprintf(stderr, "  -maxpages 40       pages per process (default %d)\n", MAXPROCPAGES);
+        fprintf(stderr, "  -pagewait 200      ticks to page in or out (default %d)\n", PAGEWAIT);
+        fprintf(stderr, "  -readwait 50       ticks to page in (default: pagewait)\n");
+        fprintf(stderr, "  -writewait 200     ticks to page out (default: pagewait)\n");
+        fprintf(stderr, "  -channels 4        swap device transfers at once (default: any)\n");
+        fprintf(stderr, "  -bandwidth 20      swap device pages per 1000 ticks (default: no cap)\n");
+        fprintf(stderr, "  -ioqueue 16        swap device requests that may wait (default: any)\n");
+        fprintf(stderr, "  -iosched demand    swap device order: fifo, demand or deadline (default fifo)\n");
+        fprintf(stderr, "  -iodeadline 300    ticks a prefetch may wait with deadline (default: readwait)\n");
+        fprintf(stderr, "  -threads 8         worker threads (default: all cores)\n");
+        fprintf(stderr, "  -nowarp            simulate every tick\n");
+        fprintf(stderr, "  -workload file.pcs run recorded pc streams instead of the programs\n");
+        fprintf(stderr, "  -programs a.pseudo run the programs of .pseudo files instead\n");
+        return errors ? EXIT_FAILURE : EXIT_SUCCESS;
+    }
+
+    /* jobs of one combination are consecutive */
+    njobs = npagers*nprocs*nframes*seeds;
+    jobs = calloc(njobs, sizeof(Job));
+    deques = calloc(nworkers, sizeof(Deque));
+    threads = calloc(nworkers, sizeof(pthread_t));
+    if (!jobs || !deques || !threads) {
+        fprintf(stderr, "%s: out of memory\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+    for (k=0, p=0; p<npagers; p++)
+        for (i=0; i<nprocs; i++)
+            for (j=0; j<nframes; j++)
+                for (s=0; s<seeds; s++, k++) {
+                    jobs[k].pager = pager[p];
+                    jobs[k].seed = seed+s;
+                    jobs[k].procs = procs[i];
+                    jobs[k].frames = frames[j];
+                }
+    for (i=0; i<nworkers; i++) {
+        pthread_mutex_init(&deques[i].lock, NULL);
+        deques[i].jobs = calloc(njobs/nworkers+1, sizeof(long));
+        if (!deques[i].jobs) {
+            fprintf(stderr, "%s: out of memory\n", argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+    for (k=0; k<njobs; k++) {
+        Deque *d = deques+k%nworkers;
+        d->jobs[d->tail++] = k;
+    }
+
+    for (i=0; i<nworkers; i++)
+        if (pthread_create(threads+i, NULL, worker, (void *)i)) {
+            fprintf(stderr, "%s: could not start worker thread\n", argv[0]);
+            return EXIT_FAILURE;
+        }
+    for (i=0; i<nworkers; i++) pthread_join(threads[i], NULL);
+
+    printf("%-10s %6s %7s %5s %12s %12s %9s %9s %19s\n", "pager", "procs", "frames", "runs",
+           "blocked", "compute", "ratio", "stddev", "95% ci");
+    for (k=0; k<njobs; k+=seeds) {
+        double sum=0, sumsq=0, mean, sd, ci, blocked=0, compute=0;
+        for (s=0; s<seeds; s++) {
+            Job *job = jobs+k+s;
+            double ratio = (double)job->blocked/(double)job->compute;
+            sum += ratio;
+            sumsq += ratio*ratio;
+            blocked += job->blocked;
+            compute += job->compute;
+        }
+        mean = sum/seeds;
+        sd = seeds>1 ? sqrt((sumsq-seeds*mean*mean)/(seeds-1)) : 0.0;
+        if (sd != sd) sd = 0.0; /* rounding below zero */
+        ci = t95(seeds-1)*sd/sqrt(seeds);
+        printf("%-10s %6ld %7ld %5ld %12.0f %12.0f %9.4f %9.4f [%8.4f,%8.4f]\n",
+               jobs[k].pager->name, jobs[k].procs, jobs[k].frames, seeds, blocked/seeds, compute/seeds,
+               mean, sd, mean-ci, mean+ci);
+    }
+
+    for (i=0; i<nworkers; i++) {
+        pthread_mutex_destroy(&deques[i].lock);
+        free(deques[i].jobs);
+    }
+    free(deques);
+    free(threads);
+    free(jobs);
+    if (workload) workload_close(workload);
+    free(programs);
+    return EXIT_SUCCESS;
+}
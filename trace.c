@@ -0,0 +1,95 @@
+/*
+ * File: trace.c
+ *
+ * Project: CSCI 3753 Programming Assignment 4
+ * Create Date: 2026/10/16
+ * Modify Date: 2026/10/16
+ * Description:
+ * 	This writes binary traces through a buffer and maps
+ *      them back into memory for reading.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "trace.h"
+
+#define TRACEBUFFER 4096 	/* records written at once */
+
+const char *trace_names[TR_EVENTS] = {
+    "branch_from", "branch_to", "blocked", "unblocked", "exit",
+    "out_of_range", "restart", "suspend", "resume", "unload", "load",
+    "going", "coming", "in", "out",
+};
+
+struct tracewriter {
+    FILE *file;
+    long nbuf;
+    Tracerec buf[TRACEBUFFER];
+};
+
+Tracewriter *trace_create(const char *path, const Traceheader *h) {
+    Tracewriter *w = malloc(sizeof(Tracewriter));
+    Traceheader header = *h;
+    if (!w) return NULL;
+    w->file = fopen(path, "wb");
+    if (!w->file) {
+        free(w);
+        return NULL;
+    }
+    memcpy(header.magic, TRACEMAGIC, sizeof(header.magic));
+    header.recsize = sizeof(Tracerec);
+    fwrite(&header, sizeof(header), 1, w->file);
+    w->nbuf = 0;
+    return w;
+}
+
+static void trace_flush(Tracewriter *w) {
+    fwrite(w->buf, sizeof(Tracerec), w->nbuf, w->file);
+    w->nbuf = 0;
+}
+
+void trace_put(Tracewriter *w, const Tracerec *r) {
+    if (w->nbuf == TRACEBUFFER) trace_flush(w);
+    w->buf[w->nbuf++] = *r;
+}
+
+void trace_close(Tracewriter *w) {
+    trace_flush(w);
+    fclose(w->file);
+    free(w);
+}
+
+int trace_map(const char *path, Trace *t) {
+    struct stat st;
+    void *map;
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return 0;
+    if (fstat(fd, &st) < 0 || (size_t)st.st_size < sizeof(Traceheader)) {
+        close(fd);
+        return 0;
+    }
+    map = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) return 0;
+    t->header = map;
+    t->size = st.st_size;
+    if (memcmp(t->header->magic, TRACEMAGIC, sizeof(t->header->magic)) != 0
+     || t->header->recsize != sizeof(Tracerec)) {
+        munmap(map, st.st_size);
+        return 0;
+    }
+    t->recs = (const Tracerec *)(t->header+1);
+    t->nrecs = (t->size-sizeof(Traceheader))/sizeof(Tracerec);
+    madvise(map, st.st_size, MADV_SEQUENTIAL);
+    return 1;
+}
+
+void trace_unmap(Trace *t) {
+    munmap((void *)t->header, t->size);
+}
@@ -0,0 +1,95 @@
+/*
+ * File: trace.h
+ *
+ * Project: CSCI 3753 Programming Assignment 4
+ * Create Date: 2026/10/16
+ * Modify Date: 2026/10/16
+ * Description:
+ * 	This is the binary trace format written by -trace: a
+ *      header followed by fixed-width event records in time
+ *      order, one for each line -csv writes to output.csv
+ *      or pages.csv.
+ */
+
+#include <stdint.h>
+
+#define TRACEMAGIC "VMTRACE2"
+
+/* events; those up to TR_LOAD go to output.csv, the rest to pages.csv.
+   A process suspended with sim_suspend() is blocked from the tick
+   after TR_SUSPEND through the tick of TR_RESUME. */
+enum {
+    TR_BRANCH_FROM, TR_BRANCH_TO, TR_BLOCKED, TR_UNBLOCKED, TR_EXIT,
+    TR_OUT_OF_RANGE, TR_RESTART, TR_SUSPEND, TR_RESUME, TR_UNLOAD, TR_LOAD,
+    TR_GOING, TR_COMING, TR_IN, TR_OUT,
+    TR_EVENTS
+};
+
+/* names of the events, as in the csv files */
+extern const char *trace_names[TR_EVENTS];
+
+struct traceheader {
+    char magic[8];          /* TRACEMAGIC */
+    int32_t recsize;        /* sizeof(Tracerec) */
+    int32_t procs;          /* number of processors */
+    int64_t seed;           /* random seed */
+    int64_t frames;         /* number of physical pages */
+    char pager[32];         /* name of the pager */
+};
+
+typedef struct traceheader Traceheader;
+
+struct tracerec {
+    int64_t clock;          /* sysclock of the event */
+    int32_t pid;            /* unique process number */
+    int32_t pc;             /* program counter (output events) */
+    int32_t kind;           /* kind of process (workload kinds are at
+                               most 10^9, see workload.c) */
+    int16_t proc;           /* processor */
+    int16_t page;           /* page (pages events), else -1 */
+    uint8_t event;          /* TR_* */
+    uint8_t pad[7];         /* to 32 bytes */
+};
+
+typedef struct tracerec Tracerec;
+
+typedef struct tracewriter Tracewriter;
+
+/* Tracewriter *trace_create(const char *path, const Traceheader *h)
+ *   This creates a trace file and writes its header.
+ * Returns:
+ *   the writer, or NULL if the file can't be written
+ */
+extern Tracewriter *trace_create(const char *path, const Traceheader *h);
+
+/* void trace_put(Tracewriter *w, const Tracerec *r)
+ *   This appends one record, buffered.
+ */
+extern void trace_put(Tracewriter *w, const Tracerec *r);
+
+/* void trace_close(Tracewriter *w)
+ *   This flushes and closes a trace file.
+ */
+extern void trace_close(Tracewriter *w);
+
+/* a trace file mapped into memory for reading */
+struct trace {
+    const Traceheader *header;
+    const Tracerec *recs;   /* in time order */
+    long nrecs;
+    size_t size;            /* of the mapping */
+};
+
+typedef struct trace Trace;
+
+/* int trace_map(const char *path, Trace *t)
+ *   This maps a trace file read-only.
+ * Returns:
+ *   1 if mapped, 0 if the file can't be read or isn't a trace
+ */
+extern int trace_map(const char *path, Trace *t);
+
+/* void trace_unmap(Trace *t)
+ *   This releases a mapped trace.
+ */
+extern void trace_unmap(Trace *t);
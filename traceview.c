@@ -0,0 +1,290 @@
+/*
+ * File: traceview.c
+ *
+ * Project: CSCI 3753 Programming Assignment 4
+ * Create Date: 2026/10/16
+ * Modify Date: 2026/10/16
+ * Description:
+ * 	This reads a binary trace written by -trace without
+ *      re-simulating: it replays the run to recover the
+ *      blocked and compute cycles reported by the simulator,
+ *      dumps events in a range of time, converts the trace
+ *      to output.csv and pages.csv for see.R, or extracts the
+ *      pc stream of every process as a workload for -workload.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+
+#include "trace.h"
+
+/* replayed totals of one process */
+typedef struct replay {
+    int loaded;     /* seen a load event */
+    long start;     /* first tick the process ran */
+    long end;       /* last tick the process ran */
+    long blocked;   /* tick of the unmatched blocked event, or -1 */
+    int suspended;  /* between a suspend and a resume event */
+    long stopped;   /* first tick blocked or suspended, if either */
+    long block;     /* blocked ticks */
+} Replay;
+
+/* pcs first..last run in sequence by a process */
+typedef struct segment {
+    long first, last;
+} Segment;
+
+/* the pc stream of one process, as segments */
+typedef struct stream {
+    long kind;
+    long nsegs, cap;
+    Segment *segs;
+} Stream;
+
+/* first record at or after clock */
+static long trace_seek(const Trace *t, long clock) {
+    long lo = 0, hi = t->nrecs;
+    while (lo < hi) {
+        long mid = (lo+hi)/2;
+        if (t->recs[mid].clock < clock) lo = mid+1;
+        else hi = mid;
+    }
+    return lo;
+}
+
+static void print_rec(FILE *f, const Tracerec *r) {
+    if (r->event <= TR_LOAD)
+        fprintf(f, "%ld,%d,%d,%d,%d,%s\n", (long)r->clock, r->proc, r->pid,
+                r->kind, r->pc, trace_names[r->event]);
+    else
+        fprintf(f, "%ld,%d,%d,%d,%d,%s\n", (long)r->clock, r->proc, r->page,
+                r->pid, r->kind, trace_names[r->event]);
+}
+
+/* recover blocked and compute cycles: a process runs on every tick
+   from its load to its unload, and is blocked from the tick of each
+   blocked event up to the tick of the matching unblocked event, and
+   while suspended: the pager suspends and resumes it after the
+   process steps of a tick, so from the tick after a suspend event
+   through the tick of the resume event (a process may be both) */
+static int replay(const Trace *t) {
+    long i, npids = 0, counts[TR_EVENTS];
+    long block = 0, compute = 0, clock = 0;
+    Replay *r = NULL;
+
+    memset(counts, 0, sizeof(counts));
+    for (i=0; i<t->nrecs; i++) {
+        const Tracerec *e = t->recs+i;
+        counts[e->event]++;
+        clock = e->clock;
+        if (e->event > TR_LOAD) continue;
+        if (e->pid >= npids) {
+            long n = e->pid+1 > 2*npids ? e->pid+1 : 2*npids;
+            r = realloc(r, n*sizeof(Replay));
+            if (!r) {
+                fprintf(stderr, "out of memory\n");
+                return 0;
+            }
+            memset(r+npids, 0, (n-npids)*sizeof(Replay));
+            npids = n;
+        }
+        switch (e->event) {
+        case TR_LOAD:
+            /* allinit() loads before the first tick runs; later
+               loads happen during a tick and run from the next */
+            r[e->pid].loaded = 1;
+            r[e->pid].start = e->clock ? e->clock+1 : 0;
+            r[e->pid].end = r[e->pid].start-1;
+            r[e->pid].blocked = -1;
+            break;
+        case TR_BLOCKED:
+            if (r[e->pid].blocked < 0 && !r[e->pid].suspended)
+                r[e->pid].stopped = e->clock;
+            r[e->pid].blocked = e->clock;
+            break;
+        case TR_UNBLOCKED:
+            if (r[e->pid].blocked >= 0 && !r[e->pid].suspended)
+                r[e->pid].block += e->clock-r[e->pid].stopped;
+            r[e->pid].blocked = -1;
+            break;
+        case TR_SUSPEND:
+            if (r[e->pid].blocked < 0 && !r[e->pid].suspended)
+                r[e->pid].stopped = e->clock+1;
+            r[e->pid].suspended = 1;
+            break;
+        case TR_RESUME:
+            if (r[e->pid].blocked < 0 && r[e->pid].suspended)
+                r[e->pid].block += e->clock+1-r[e->pid].stopped;
+            r[e->pid].suspended = 0;
+            break;
+        case TR_UNLOAD:
+            r[e->pid].end = e->clock;
+            break;
+        }
+    }
+    for (i=0; i<npids; i++) {
+        if (!r[i].loaded) continue;
+        block += r[i].block;
+        compute += r[i].end-r[i].start+1-r[i].block;
+    }
+    free(r);
+
+    printf("pager %s, seed %ld, %d processors, %ld physical pages\n",
+           t->header->pager, (long)t->header->seed, t->header->procs,
+           (long)t->header->frames);
+    printf("%ld events through tick %ld\n", t->nrecs, clock);
+    for (i=0; i<TR_EVENTS; i++)
+        if (counts[i]) printf("%12ld %s\n", counts[i], trace_names[i]);
+    printf("%ld blocked cycles\n", block);
+    printf("%ld compute cycles\n", compute);
+    printf("ratio blocked/compute=%g\n", (double)block/(double)compute);
+    return 1;
+}
+
+static int tocsv(const Trace *t) {
+    long i;
+    FILE *output = fopen("output.csv", "w");
+    FILE *pages = fopen("pages.csv", "w");
+    if (!output || !pages) {
+        fprintf(stderr, "could not open output.csv and pages.csv for writing\n");
+        return 0;
+    }
+    for (i=0; i<t->nrecs; i++)
+        print_rec(t->recs[i].event <= TR_LOAD ? output : pages, t->recs+i);
+    fclose(output);
+    fclose(pages);
+    return 1;
+}
+
+static int stream_add(Stream *s, long first) {
+    if (s->nsegs == s->cap) {
+        Segment *segs;
+        s->cap = s->cap ? 2*s->cap : 16;
+        segs = realloc(s->segs, s->cap*sizeof(Segment));
+        if (!segs) return 0;
+        s->segs = segs;
+    }
+    s->segs[s->nsegs].first = first;
+    s->segs[s->nsegs++].last = first-1;
+    return 1;
+}
+
+/* write the pcs each process ran, in pid order: a process runs
+   in sequence from where it is loaded, and a branch, a restart or
+   its exit ends each run */
+static int topcs(const Trace *t, const char *path) {
+    long i, pc, n, npids = 0;
+    int ok = 1;
+    Stream *s = NULL;
+    FILE *f;
+
+    for (i=0; i<t->nrecs && ok; i++) {
+        const Tracerec *e = t->recs+i;
+        Stream *q;
+        if (e->event > TR_LOAD) continue;
+        if (e->pid >= npids) {
+            long n = e->pid+1 > 2*npids ? e->pid+1 : 2*npids;
+            Stream *grown = realloc(s, n*sizeof(Stream));
+            if (!grown) {
+                ok = 0;
+                break;
+            }
+            s = grown;
+            memset(s+npids, 0, (n-npids)*sizeof(Stream));
+            npids = n;
+        }
+        q = s+e->pid;
+        switch (e->event) {
+        case TR_LOAD:
+            q->kind = e->kind;
+            ok = stream_add(q, e->pc);
+            break;
+        case TR_BRANCH_TO:
+        case TR_RESTART:
+            ok = stream_add(q, e->pc);
+            break;
+        case TR_BRANCH_FROM:
+        case TR_EXIT:
+            if (q->nsegs) q->segs[q->nsegs-1].last = e->pc;
+            break;
+        case TR_OUT_OF_RANGE:
+            if (q->nsegs) q->segs[q->nsegs-1].last = e->pc-1;
+            break;
+        }
+    }
+    if (!ok) fprintf(stderr, "out of memory\n");
+
+    f = ok ? fopen(path, "w") : NULL;
+    if (ok && !f) {
+        fprintf(stderr, "could not open %s for writing\n", path);
+        ok = 0;
+    }
+    for (i=0; ok && i<npids; i++) {
+        long j;
+        if (!s[i].nsegs) continue;
+        fprintf(f, "process %ld\n", s[i].kind);
+        for (n=0, j=0; j<s[i].nsegs; j++)
+            for (pc=s[i].segs[j].first; pc<=s[i].segs[j].last; pc++)
+                fprintf(f, "%ld%c", pc, ++n%16 ? ' ' : '\n');
+        if (n%16) fprintf(f, "\n");
+    }
+    if (f) fclose(f);
+    for (i=0; i<npids; i++) free(s[i].segs);
+    free(s);
+    return ok;
+}
+
+int main(int argc, char **argv) {
+    long i, errors=0, from=0, to=-1;
+    int dump=0, csv=0, ok;
+    const char *path = NULL, *pcs = NULL;
+    Trace t;
+
+    for (i=1; i<argc; i++) {
+        if (strcmp(argv[i],"-dump")==0) {
+            dump = 1;
+        } else if (strcmp(argv[i],"-csv")==0) {
+            csv = 1;
+        } else if (strcmp(argv[i],"-pcs")==0 && i+1<argc) {
+            pcs = argv[++i];
+        } else if (strcmp(argv[i],"-from")==0 && i+1<argc) {
+            if (sscanf(argv[++i],"%ld",&from)!=1) errors++;
+        } else if (strcmp(argv[i],"-to")==0 && i+1<argc) {
+            if (sscanf(argv[++i],"%ld",&to)!=1) errors++;
+        } else if (argv[i][0] != '-' && !path) {
+            path = argv[i];
+        } else {
+            fprintf(stderr, "%s: unrecognized argument %s\n", argv[0], argv[i]);
+            errors++;
+        }
+    }
+    if (errors || !path) {
+        fprintf(stderr, "%s usage: %s [options] trace.bin\n", argv[0], argv[0]);
+        fprintf(stderr, "  (none)       replay the blocked and compute cycles\n");
+        fprintf(stderr, "  -dump        print the events in csv form\n");
+        fprintf(stderr, "  -from 1000   ... starting at tick 1000\n");
+        fprintf(stderr, "  -to 2000     ... through tick 2000\n");
+        fprintf(stderr, "  -csv         write output.csv and pages.csv for see.R\n");
+        fprintf(stderr, "  -pcs run.pcs write the pcs of each process, for -workload\n");
+        return EXIT_FAILURE;
+    }
+    if (!trace_map(path, &t)) {
+        fprintf(stderr, "%s: %s is not a readable trace\n", argv[0], path);
+        return EXIT_FAILURE;
+    }
+
+    if (dump) {
+        for (i=trace_seek(&t, from); i<t.nrecs && (to<0 || t.recs[i].clock<=to); i++)
+            print_rec(stdout, t.recs+i);
+        ok = 1;
+    } else if (csv) {
+        ok = tocsv(&t);
+    } else if (pcs) {
+        ok = topcs(&t, pcs);
+    } else {
+        ok = replay(&t);
+    }
+    trace_unmap(&t);
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,211 @@
+/*
+ * File: workload.c
+ *
+ * Project: CSCI 3753 Programming Assignment 4
+ * Create Date: 2026/10/16
+ * Modify Date: 2026/10/16
+ * Description:
+ * 	This indexes workload files of recorded PC streams
+ *      and reads each stream back a chunk at a time.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <ctype.h>
+
+#include "workload.h"
+
+enum { TOK_END, TOK_PC, TOK_PROCESS, TOK_ERROR };
+
+#define MAXTOKENPC 1000000000L 	/* larger numbers are errors */
+
+/* read the next pc, or a process line and its kind; newlines
+   are left for the caller so that line counts stay right */
+static int token(FILE *f, long *value, long *line) {
+    int c;
+    char word[16];
+    long n;
+
+    for (;;) {
+        c = getc(f);
+        if (c == EOF) return TOK_END;
+        if (c == '\n') {
+            if (line) (*line)++;
+        } else if (c == '#') {
+            while ((c = getc(f)) != EOF && c != '\n') ;
+            if (c == '\n') ungetc(c, f);
+        } else if (!isspace(c)) {
+            break;
+        }
+    }
+
+    if (isdigit(c)) {
+        *value = 0;
+        for (; c != EOF && isdigit(c); c = getc(f)) {
+            *value = *value*10 + (c-'0');
+            if (*value > MAXTOKENPC) return TOK_ERROR;
+        }
+        if (c == EOF) return TOK_PC;
+        ungetc(c, f);
+        return isspace(c) || c == '#' ? TOK_PC : TOK_ERROR;
+    }
+
+    for (n=0; c != EOF && isalpha(c) && n+1 < (long)sizeof(word); c = getc(f))
+        word[n++] = c;
+    word[n] = '\0';
+    if (strcmp(word, "process") != 0) return TOK_ERROR;
+    *value = 0;
+    while (c == ' ' || c == '\t') c = getc(f);
+    for (; c != EOF && isdigit(c); c = getc(f)) {
+        *value = *value*10 + (c-'0');
+        if (*value > MAXTOKENPC) return TOK_ERROR;
+    }
+    while (c == ' ' || c == '\t') c = getc(f);
+    if (c == '#') while ((c = getc(f)) != EOF && c != '\n') ;
+    if (c == EOF) return TOK_PROCESS;
+    ungetc(c, f);
+    return c == '\n' ? TOK_PROCESS : TOK_ERROR;
+}
+
+Workload *workload_open(const char *path) {
+    FILE *f;
+    Workload *w;
+    struct wlprocess *p;
+    long value, line=1, cap=0, i;
+    int t;
+
+    f = fopen(path, "r");
+    if (!f) {
+        fprintf(stderr, "%s: can't open workload\n", path);
+        return NULL;
+    }
+    w = calloc(1, sizeof(Workload));
+    if (!w || !(w->path = strdup(path))) {
+        fprintf(stderr, "%s: out of memory\n", path);
+        goto fail;
+    }
+    while ((t = token(f, &value, &line)) != TOK_END) {
+        if (t == TOK_ERROR) {
+            fprintf(stderr, "%s:%ld: expected a pc or a process line\n", path, line);
+            goto fail;
+        }
+        if (t == TOK_PROCESS) {
+            if (w->nprocs == cap) {
+                cap = cap ? 2*cap : 64;
+                p = realloc(w->procs, cap*sizeof(struct wlprocess));
+                if (!p) {
+                    fprintf(stderr, "%s: out of memory\n", path);
+                    goto fail;
+                }
+                w->procs = p;
+            }
+            p = w->procs + w->nprocs++;
+            p->offset = -1;
+            p->first = -1;
+            p->kind = value;
+            p->length = 0;
+            continue;
+        }
+        if (!w->nprocs) {
+            fprintf(stderr, "%s:%ld: pc before the first process line\n", path, line);
+            goto fail;
+        }
+        p = w->procs + w->nprocs-1;
+        if (p->length++ == 0) {
+            p->first = value;
+            p->offset = ftell(f);
+        }
+        if (value > w->maxpc) w->maxpc = value;
+    }
+    if (!w->nprocs) {
+        fprintf(stderr, "%s: no processes\n", path);
+        goto fail;
+    }
+    for (i=0; i<w->nprocs; i++)
+        if (!w->procs[i].length) {
+            fprintf(stderr, "%s: process with pid %ld has no pcs\n", path, i);
+            goto fail;
+        }
+    w->file = f;
+    return w;
+
+fail:
+    fclose(f);
+    if (w) workload_close(w);
+    return NULL;
+}
+
+void workload_close(Workload *w) {
+    if (w->file) fclose(w->file);
+    free(w->path);
+    free(w->procs);
+    free(w);
+}
+
+void pcstream_init(Pcstream *s, const Workload *w, long proc) {
+    s->workload = w;
+    s->proc = proc;
+    s->offset = w->procs[proc].offset;
+    s->left = w->procs[proc].length-1;
+    s->buf = NULL;
+    s->next = s->nbuf = 0;
+}
+
+/* a stream that ends early would end its process early, and
+   the run would finish with the wrong totals */
+static void pcstream_die(Pcstream *s, const char *why) {
+    fprintf(stderr, "%s: %s\n", s->workload->path, why);
+    exit(EXIT_FAILURE);
+}
+
+/* top the buffer up to PCCHUNK unconsumed pcs */
+static void pcstream_fill(Pcstream *s) {
+    FILE *f = s->workload->file;
+    long value;
+    if (s->left<=0 || s->nbuf-s->next==PCCHUNK) return;
+    if (!s->buf) {
+        s->buf = malloc(PCCHUNK*sizeof(long));
+        if (!s->buf) pcstream_die(s, "out of memory");
+    }
+    memmove(s->buf, s->buf+s->next, (s->nbuf-s->next)*sizeof(long));
+    s->nbuf -= s->next;
+    s->next = 0;
+    // every stream reads the one file from its own offset, so
+    // hold it from the seek to the last pc (sweep shares it
+    // between threads)...
+    flockfile(f);
+    if (fseek(f, s->offset, SEEK_SET) != 0) pcstream_die(s, "can't seek in workload");
+    while (s->left>0 && s->nbuf<PCCHUNK) {
+        if (token(f, &value, NULL) != TOK_PC) pcstream_die(s, "changed while being read");
+        s->buf[s->nbuf++] = value;
+        s->left--;
+    }
+    s->offset = ftell(f);
+    funlockfile(f);
+}
+
+int pcstream_next(Pcstream *s, long *pc) {
+    if (s->next==s->nbuf) pcstream_fill(s);
+    if (s->next==s->nbuf) return 0;
+    *pc = s->buf[s->next++];
+    return 1;
+}
+
+long pcstream_run(Pcstream *s, long pc, long limit) {
+    long n = 0;
+    if (s->nbuf-s->next < limit) pcstream_fill(s);
+    while (n<limit && s->next+n<s->nbuf && s->buf[s->next+n]==pc+n+1) n++;
+    return n;
+}
+
+void pcstream_skip(Pcstream *s, long n) {
+    s->next += n;
+}
+
+void pcstream_close(Pcstream *s) {
+    free(s->buf);
+    s->buf = NULL;
+    s->left = 0;
+    s->next = s->nbuf = 0;
+}
@@ -0,0 +1,104 @@
+/*
+ * File: workload.h
+ *
+ * Project: CSCI 3753 Programming Assignment 4
+ * Create Date: 2026/10/16
+ * Modify Date: 2026/10/16
+ * Description:
+ * 	This is a workload of recorded PC streams, run in place
+ *      of the programs in programs.c. A workload file lists its
+ *      processes in queue order; each starts with a line
+ *
+ *          process [kind]
+ *
+ *      followed by the pcs the process visits, in order, as
+ *      whitespace separated decimal numbers. '#' starts a
+ *      comment that runs to the end of the line. The file is
+ *      indexed once when opened and each stream is then read
+ *      in chunks as its process runs, so it need not fit in
+ *      memory.
+ */
+
+#include <stdio.h>
+
+#define PCCHUNK 4096 	/* pcs read from a stream at once */
+
+/* where one process of a workload file starts */
+struct wlprocess {
+    long offset;            /* file position after the first pc */
+    long first;             /* first pc */
+    long kind;              /* kind from the process line, or 0 */
+    long length;            /* number of pcs */
+};
+
+struct workload {
+    char *path;
+    FILE *file;             /* open while the workload is, and shared
+                               by every stream of it */
+    long nprocs;
+    struct wlprocess *procs;
+    long maxpc;             /* largest pc of any process */
+};
+
+typedef struct workload Workload;
+
+/* Workload *workload_open(const char *path)
+ *   This indexes a workload file, reporting any
+ *   syntax error on stderr.
+ * Returns:
+ *   the workload, or NULL if it can't be read
+ */
+extern Workload *workload_open(const char *path);
+
+/* void workload_close(Workload *w)
+ *   This releases a workload; no stream of it may
+ *   still be open.
+ */
+extern void workload_close(Workload *w);
+
+/* the remaining pcs of one process, read on demand */
+struct pcstream {
+    const Workload *workload;
+    long proc;              /* process of the workload */
+    long offset;            /* file position of the next chunk */
+    long left;              /* pcs not yet read from the file */
+    long *buf;
+    long next, nbuf;        /* unconsumed pcs are buf[next..nbuf-1] */
+};
+
+typedef struct pcstream Pcstream;
+
+/* void pcstream_init(Pcstream *s, const Workload *w, long proc)
+ *   This prepares to stream the pcs after the first of
+ *   process proc; nothing is read until they are needed.
+ *   Streams read the workload's one file at their own
+ *   offsets, so any number may be open at once (and in
+ *   several threads); a stream that can't be read ends
+ *   the program rather than end early.
+ */
+extern void pcstream_init(Pcstream *s, const Workload *w, long proc);
+
+/* int pcstream_next(Pcstream *s, long *pc)
+ *   This takes the next pc of the stream.
+ * Returns:
+ *   1 with *pc set, or 0 at the end of the stream
+ */
+extern int pcstream_next(Pcstream *s, long *pc);
+
+/* long pcstream_run(Pcstream *s, long pc, long limit)
+ *   This looks ahead without consuming anything.
+ * Returns:
+ *   how many of the next pcs, up to limit, are
+ *   pc+1, pc+2, ... in sequence
+ */
+extern long pcstream_run(Pcstream *s, long pc, long limit);
+
+/* void pcstream_skip(Pcstream *s, long n)
+ *   This consumes n pcs already seen by pcstream_run().
+ */
+extern void pcstream_skip(Pcstream *s, long n);
+
+/* void pcstream_close(Pcstream *s)
+ *   This releases the buffer of a stream.
+ */
+extern void pcstream_close(Pcstream *s);